@@ -0,0 +1,532 @@
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Attack.h"
+#include "EntityStore.h"
+#include "Enums.h"
+#include "Exceptions.h"
+#include "Game.h"
+#include "GlobalDefinitions.h"
+#include "JobSystem.h"
+#include "ParticleKernel.h"
+#include "ParticleSystem.h"
+#include "SpatialHash.h"
+
+/**
+ * Microbenchmarks for the simulation and rendering hot paths.
+ *
+ * Every benchmark runs for each entity count in ENTITY_COUNTS and reports nanoseconds per iteration as JSON, on
+ * stdout or in the file given with --output, so runs can be compared across commits. Before timing anything, it
+ * checks every SIMD level of the particle kernel the CPU supports against the libm code the kernel replaced, and fails
+ * if one strays past the tolerances documented in ParticleKernel.h.
+ *
+ * Usage: perfectform_bench [--output <file>] [--max-entities <count>]
+ */
+
+constexpr std::array<std::size_t, 6> ENTITY_COUNTS = {1, 10, 100, 1000, 10000, 100000};
+constexpr std::array<std::size_t, 5> THREAD_COUNTS = {1, 2, 4, 8, 16};
+constexpr double MIN_BENCH_SECONDS = 0.25;        // Minimum timed duration per benchmark and entity count
+constexpr std::size_t MIN_SAMPLES = 5;            // Minimum timed iterations per benchmark and entity count
+constexpr std::size_t MAX_SAMPLES = 100000;       // Maximum timed iterations per benchmark and entity count
+constexpr std::size_t ENTITIES_PER_PLAYER = 100;  // Mixed populations hold one player per this many entities
+constexpr double NANOSECONDS_PER_SECOND = 1e9;
+
+constexpr float SPATIAL_AREA_PER_ENTITY = 64.0F * 64.0F;  // World area per entity in the spatial hash benchmarks
+constexpr std::size_t SPATIAL_QUERY_COUNT = 1000;         // Queries per iteration of the spatial query benchmark
+constexpr float SPATIAL_QUERY_RADIUS = 128.0F;
+
+constexpr std::size_t KERNEL_CHECK_PARTICLES = 4099;  // Not a multiple of any SIMD width, so the scalar tail runs too
+constexpr Uint64 KERNEL_CHECK_SEED = 0x5eed;          // Every SIMD level is checked against the same particles
+
+namespace
+{
+struct Options
+{
+    std::string outputPath;                         // Empty to print on stdout
+    std::size_t maxEntities{ENTITY_COUNTS.back()};  // Skip entity counts above this
+};
+
+struct Result
+{
+    std::string name;
+    std::size_t entities{0};
+    std::size_t samples{0};
+    double meanNs{0.0};
+    double medianNs{0.0};
+    double minNs{0.0};
+};
+
+/**
+ * Calls `setup` (untimed) then `body` (timed) until both the minimum duration and sample count are reached.
+ */
+template<typename Setup, typename Body>
+Result Measure(std::string_view name, std::size_t entities, Setup&& setup, Body&& body)
+{
+    const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const auto minCounter = static_cast<Uint64>(MIN_BENCH_SECONDS * frequency);
+
+    // One untimed round to warm caches and grow any lazily sized buffer
+    setup();
+    body();
+
+    std::vector<Uint64> samples;
+    samples.reserve(MIN_SAMPLES);
+    Uint64 total = 0;
+    while ((samples.size() < MIN_SAMPLES || total < minCounter) && samples.size() < MAX_SAMPLES)
+    {
+        setup();
+        const Uint64 start = SDL_GetPerformanceCounter();
+        body();
+        const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+        samples.push_back(elapsed);
+        total += elapsed;
+    }
+
+    std::ranges::sort(samples);
+    const double toNs = NANOSECONDS_PER_SECOND / frequency;
+    Result result;
+    result.name = name;
+    result.entities = entities;
+    result.samples = samples.size();
+    result.meanNs = static_cast<double>(total) * toNs / static_cast<double>(samples.size());
+    result.medianNs = static_cast<double>(samples[samples.size() / 2]) * toNs;
+    result.minNs = static_cast<double>(samples.front()) * toNs;
+    SDL_Log("%-20s %7zu entities: %12.0f ns/iter (median %.0f, %zu samples)",
+            result.name.c_str(),
+            result.entities,
+            result.meanNs,
+            result.medianNs,
+            result.samples);
+    return result;
+}
+
+/**
+ * Builds a population of players and attacks spread over the window, with one player per ENTITIES_PER_PLAYER.
+ */
+PF::EntityStore MakePopulation(std::size_t entities, std::size_t textureIdx, bool attacking)
+{
+    const SDL_FRect srcRect = {0, 0, 64.0F, 64.0F};
+    PF::EntityStore store;
+    PF::ParticleSystem& particles = store.getParticles();
+    const std::size_t attacks = particles.addEmitter(PF::Attack::makeEmitterConfig(textureIdx, srcRect));
+    particles.getEmitter(attacks).setLimit(std::max(entities, PF::Global::Model::MAX_ATTACK_COUNT),
+                                           PF::PoolOverflowPolicy::RECYCLE_OLDEST);
+
+    const float width = PF::Global::Window::DEFAULT_WIDTH;
+    const float height = PF::Global::Window::DEFAULT_HEIGHT;
+    const std::size_t players = std::max<std::size_t>(1, entities / ENTITIES_PER_PLAYER);
+    for (std::size_t i = 0; i < entities; ++i)
+    {
+        // Spread over the camera's initial view, which is centred on the world origin
+        const SDL_FPoint position = {(SDL_randf() - 0.5F) * width, (SDL_randf() - 0.5F) * height};
+        if (i < players)
+        {
+            const std::size_t player = store.getPlayers().add(textureIdx, srcRect, position, 1.0F, i);
+            particles.attach({.kind = PF::PlayerStore::KIND, .index = static_cast<std::uint32_t>(player)}, attacks);
+            continue;
+        }
+        const SDL_FPoint velocity = {(SDL_randf() - 0.5F) * 8.0F, (SDL_randf() - 0.5F) * 8.0F};
+        particles.getEmitter(attacks).spawn(position, velocity, 0.3333F, i);
+    }
+
+    if (attacking) { store.handleEvent(PF::PlayerIntention::ATTACK); }
+    return store;
+}
+
+void BenchUpdate(std::vector<Result>& results, std::size_t entities)
+{
+    PF::Game game(nullptr);
+    const PF::EntityStore population = MakePopulation(entities, 0, true /*attacking*/);
+    results.push_back(Measure(
+        "update",
+        entities,
+        [&] { game.getEntities() = population; },
+        [&] { game.update(PF::Global::Model::SIMULATION_STEP_RATE_MS); }));
+}
+
+void BenchUpdateScaling(std::vector<Result>& results, std::size_t entities)
+{
+    // Same workload as "update" on the largest population, with a growing number of threads
+    const PF::EntityStore population = MakePopulation(entities, 0, true /*attacking*/);
+    for (const std::size_t threads : THREAD_COUNTS)
+    {
+        PF::Game game(nullptr, threads);
+        results.push_back(Measure(
+            std::format("update_threads_{}", threads),
+            entities,
+            [&] { game.getEntities() = population; },
+            [&] { game.update(PF::Global::Model::SIMULATION_STEP_RATE_MS); }));
+    }
+}
+
+void BenchSpawnChurn(std::vector<Result>& results, std::size_t entities)
+{
+    // Attacks spawned at size zero expire on their first update, so each iteration spawns and erases `entities`
+    PF::Game game(nullptr);
+    const PF::EntityStore population = MakePopulation(0, 0, false /*attacking*/);
+    results.push_back(Measure(
+        "spawn_churn",
+        entities,
+        [&]
+        {
+            game.getEntities() = population;
+            game.getEntities().getParticles().getEmitter(0).setLimit(entities, PF::PoolOverflowPolicy::RECYCLE_OLDEST);
+        },
+        [&]
+        {
+            PF::ParticleEmitter& attacks = game.getEntities().getParticles().getEmitter(0);
+            for (std::size_t i = 0; i < entities; ++i) { attacks.spawn({0.0F, 0.0F}, {1.0F, 1.0F}, 0.0F, i); }
+            game.update(PF::Global::Model::SIMULATION_STEP_RATE_MS);
+        }));
+}
+
+void BenchHandleEvent(std::vector<Result>& results, std::size_t entities)
+{
+    // Every player is walked through the movement states by the presses, and back to IDLE by the releases. The store
+    // holds back a release that arrives in the same step as its press, so an untimed step separates the two halves.
+    constexpr std::array<PF::PlayerIntention, 5> PRESSES = {PF::PlayerIntention::MOVE_UP,
+                                                            PF::PlayerIntention::MOVE_LEFT,
+                                                            PF::PlayerIntention::ATTACK,
+                                                            PF::PlayerIntention::MOVE_DOWN,
+                                                            PF::PlayerIntention::MOVE_RIGHT};
+    constexpr std::array<PF::PlayerIntention, 5> RELEASES = {PF::PlayerIntention::MOVE_STOP_UP,
+                                                             PF::PlayerIntention::MOVE_STOP_LEFT,
+                                                             PF::PlayerIntention::ATTACK_STOP,
+                                                             PF::PlayerIntention::MOVE_STOP_DOWN,
+                                                             PF::PlayerIntention::MOVE_STOP_RIGHT};
+    PF::JobSystem jobSystem(1);
+    PF::EntityStore players;
+    const SDL_FRect srcRect = {0, 0, 64.0F, 64.0F};
+    for (std::size_t i = 0; i < entities; ++i) { players.getPlayers().add(0, srcRect, {0.0F, 0.0F}, 1.0F, i); }
+
+    const auto send = [&](const auto& intentions)
+    {
+        for (const auto intention : intentions) { players.handleEvent(intention); }
+    };
+    const auto step = [&] { players.update(PF::Global::Model::SIMULATION_STEP_RATE_MS, jobSystem); };
+
+    results.push_back(Measure(
+        "handle_event_press",
+        entities,
+        [&]
+        {
+            send(RELEASES);
+            step();
+        },
+        [&] { send(PRESSES); }));
+    results.push_back(Measure(
+        "handle_event_release",
+        entities,
+        [&]
+        {
+            send(PRESSES);
+            step();
+        },
+        [&] { send(RELEASES); }));
+}
+
+void BenchSpatialHash(std::vector<Result>& results, std::size_t entities)
+{
+    // The world grows with the population at a constant density, so every query finds about as many neighbours: the
+    // rebuild should grow linearly with the population, and the queries stay flat
+    const float side = std::sqrt(static_cast<float>(entities) * SPATIAL_AREA_PER_ENTITY);
+    const auto randomPoint = [side] { return SDL_FPoint{(SDL_randf() - 0.5F) * side, (SDL_randf() - 0.5F) * side}; };
+
+    PF::EmitterConfig config = PF::Attack::makeEmitterConfig(0, {0, 0, 64.0F, 64.0F});
+    config.capacity = entities;
+    PF::ParticleSystem particles;
+    PF::ParticleEmitter& emitter = particles.getEmitter(particles.addEmitter(config));
+    for (std::size_t i = 0; i < entities; ++i) { emitter.spawn(randomPoint(), {0.0F, 0.0F}, 0.3333F, i); }
+
+    PF::SpatialHash hash;
+    hash.reserve(entities);
+    const auto rebuild = [&]
+    {
+        hash.beginBuild();
+        hash.insert(particles);
+        hash.finishBuild();
+    };
+    results.push_back(Measure("spatial_rebuild", entities, [] {}, rebuild));
+
+    std::vector<SDL_FPoint> centres(SPATIAL_QUERY_COUNT);
+    for (SDL_FPoint& centre : centres) { centre = randomPoint(); }
+    rebuild();
+    std::size_t found = 0;
+    results.push_back(Measure(
+        "spatial_query",
+        entities,
+        [&] { found = 0; },
+        [&]
+        {
+            for (const SDL_FPoint centre : centres)
+            {
+                hash.queryRadius(centre, SPATIAL_QUERY_RADIUS, [&](PF::EntityRef, const SDL_FRect&) { ++found; });
+            }
+        }));
+    SDL_Log("%-20s %7zu entities: %.1f neighbours per query",
+            "spatial_query",
+            entities,
+            static_cast<double>(found) / SPATIAL_QUERY_COUNT);
+}
+
+void BenchRender(std::vector<Result>& results, std::size_t entities, SDL_Renderer* renderer)
+{
+    try
+    {
+        // Load synchronously, the game's own texture only shows up once uploaded between frames
+        PF::Game game(renderer);
+        const PF::TextureHandle texture = game.getTextureManager().addTexture("../../assets/BaseCell_64x64.png");
+        game.getEntities() = MakePopulation(entities, texture.get(), false /*attacking*/);
+        results.push_back(Measure(
+            "render",
+            entities,
+            [] {},
+            [&]
+            {
+                // Capturing the snapshot is part of the cost of drawing a frame, even if another thread pays it
+                game.publishSnapshot(0);
+                game.acquireSnapshot();
+                game.render(1.0F);
+            }));
+    }
+    catch (const std::exception& e)
+    {
+        // Most likely the assets are not reachable from the working directory, the other benchmarks still apply
+        SDL_Log("Skipping render benchmark: %s", e.what());
+    }
+}
+
+struct KernelErrors
+{
+    float trig{0.0F};
+    float position{0.0F};
+    float size{0.0F};
+};
+
+/**
+ * Checks whether the running CPU can execute `level`, as opposed to the kernel merely being compiled for it.
+ */
+bool IsSupported(PF::SimdLevel level, PF::SimdLevel widest)
+{
+    if (level == PF::SimdLevel::SCALAR || level == widest) { return true; }
+    return level == PF::SimdLevel::SSE2 && widest == PF::SimdLevel::AVX2;  // Every AVX2 CPU has SSE2
+}
+
+/**
+ * Advances KERNEL_CHECK_PARTICLES particles by one step at `simdLevel`, and measures how far they land from the
+ * per-object libm code the kernel replaced.
+ */
+KernelErrors MeasureKernelErrors(PF::SimdLevel simdLevel)
+{
+    Uint64 randomState = KERNEL_CHECK_SEED;
+    constexpr auto STEP_MS = static_cast<float>(PF::Global::Model::SIMULATION_STEP_RATE_MS);
+    const std::size_t count = KERNEL_CHECK_PARTICLES;
+    std::vector<float> positionX(count);
+    std::vector<float> positionY(count);
+    std::vector<float> velocityX(count);
+    std::vector<float> velocityY(count);
+    std::vector<float> size(count);
+    std::vector<float> angle(count);
+    std::vector<float> random(count);
+    const PF::ParticleKernel::Batch batch = {.positionX = positionX.data(),
+                                             .positionY = positionY.data(),
+                                             .velocityX = velocityX.data(),
+                                             .velocityY = velocityY.data(),
+                                             .size = size.data(),
+                                             .angle = angle.data(),
+                                             .random = random.data(),
+                                             .count = count};
+    KernelErrors errors;
+
+    // Standing still with a unit wobble and no angle growth, a particle moves by exactly (sin, cos) of its angle
+    const PF::ParticleMotion probe = {.wobble = 1.0F};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        positionX[i] = positionY[i] = velocityX[i] = velocityY[i] = size[i] = random[i] = 0.0F;
+        angle[i] = ((SDL_randf_r(&randomState) * 2.0F) - 1.0F) * PF::ParticleKernel::TRIG_ANGLE_RANGE;
+    }
+    const std::vector<float> probeAngle = angle;
+    PF::ParticleKernel::update(batch, probe, STEP_MS, simdLevel);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        errors.trig = std::max({errors.trig,
+                                std::fabs(positionX[i] - std::sin(probeAngle[i])),
+                                std::fabs(positionY[i] - std::cos(probeAngle[i]))});
+    }
+
+    // Attacks as MakePopulation spawns them, from the origin so the error is not lost in the rounding of the position.
+    // Their angles go as far as the multipliers of the motion keep every sin/cos argument within the checked range.
+    const PF::ParticleMotion motion = PF::Attack::makeEmitterConfig(0, {}).motion;
+    const float maxAngle = PF::ParticleKernel::TRIG_ANGLE_RANGE /
+                           std::max({1.0F, motion.cosAngleMultiplier, motion.sizeOscillationMultiplier});
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        positionX[i] = positionY[i] = 0.0F;
+        velocityX[i] = (SDL_randf_r(&randomState) - 0.5F) * 8.0F;
+        velocityY[i] = (SDL_randf_r(&randomState) - 0.5F) * 8.0F;
+        size[i] = 0.3333F;
+        angle[i] = SDL_randf_r(&randomState) * maxAngle;
+        random[i] = SDL_randf_r(&randomState);
+    }
+    const std::vector<float> startVelocityX = velocityX;
+    const std::vector<float> startVelocityY = velocityY;
+    const std::vector<float> startSize = size;
+    const std::vector<float> startAngle = angle;
+    PF::ParticleKernel::update(batch, motion, STEP_MS, simdLevel);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float referenceAngle = startAngle[i] + (STEP_MS * motion.angleIncrement * random[i]);
+        const float sinAngle = std::sin(referenceAngle);
+        const float cosAngle = std::cos(motion.cosAngleMultiplier * referenceAngle);
+        const float sinSize = std::sin(referenceAngle * motion.sizeOscillationMultiplier);
+        const float referenceX = (startVelocityX[i] * (1 + sinAngle)) + (motion.wobble * sinAngle);
+        const float referenceY = (startVelocityY[i] * (1 + cosAngle)) + (motion.wobble * cosAngle);
+        const float referenceSize =
+            startSize[i] + (sinSize * motion.sizeOscillation) - (motion.sizeDecay * referenceAngle);
+        errors.position =
+            std::max({errors.position, std::fabs(positionX[i] - referenceX), std::fabs(positionY[i] - referenceY)});
+        errors.size = std::max(errors.size, std::fabs(size[i] - referenceSize));
+    }
+    return errors;
+}
+
+/**
+ * Throws if any SIMD level the CPU supports strays from the libm reference past the tolerances of ParticleKernel.h.
+ */
+void CheckParticleKernel()
+{
+    const PF::SimdLevel widest = PF::ParticleKernel::detectSimdLevel();
+    for (std::size_t level = 0; level < static_cast<std::size_t>(PF::SimdLevel::SimdLevel_Last); ++level)
+    {
+        const auto simdLevel = static_cast<PF::SimdLevel>(level);
+        if (!IsSupported(simdLevel, widest)) { continue; }
+
+        const KernelErrors errors = MeasureKernelErrors(simdLevel);
+        SDL_Log("particle kernel %-6s: sin/cos error %.2g, position error %.2g px, size error %.2g",
+                PF::toString(simdLevel),
+                errors.trig,
+                errors.position,
+                errors.size);
+        if (errors.trig > PF::ParticleKernel::TRIG_TOLERANCE ||
+            errors.position > PF::ParticleKernel::POSITION_TOLERANCE ||
+            errors.size > PF::ParticleKernel::SIZE_TOLERANCE)
+        {
+            throw PF::Exception(
+                std::format("Particle kernel {} exceeds its documented tolerance", PF::toString(simdLevel)));
+        }
+    }
+}
+
+Options ParseOptions(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument != "--output" && argument != "--max-entities")
+        {
+            throw PF::Exception(std::format("Unknown command line argument: {}", argument));
+        }
+        if (i + 1 >= argc) { throw PF::Exception(std::format("Missing value for argument: {}", argument)); }
+
+        const std::string_view value = argv[++i];
+        if (argument == "--output") { options.outputPath = value; }
+        else
+        {
+            const char* last = value.data() + value.size();
+            const auto [end, error] = std::from_chars(value.data(), last, options.maxEntities);
+            if (error != std::errc{} || end != last)
+            {
+                throw PF::Exception(std::format("Invalid entity count for --max-entities: {}", value));
+            }
+        }
+    }
+    return options;
+}
+
+std::string ToJson(const std::vector<Result>& results, PF::SimdLevel simdLevel)
+{
+    std::string json = std::format("{{\n  \"simd_level\": \"{}\",\n  \"benchmarks\": [\n", PF::toString(simdLevel));
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        json += std::format(
+            "    {{\"name\": \"{}\", \"entities\": {}, \"samples\": {}, \"mean_ns\": {:.1f}, \"median_ns\": {:.1f}, "
+            "\"min_ns\": {:.1f}}}{}\n",
+            result.name,
+            result.entities,
+            result.samples,
+            result.meanNs,
+            result.medianNs,
+            result.minNs,
+            i + 1 < results.size() ? "," : "");
+    }
+    json += "  ]\n}\n";
+    return json;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    SDL_Surface* surface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    int exitCode = 0;
+    try
+    {
+        const Options options = ParseOptions(argc, argv);
+
+        // Software rendering into an offscreen surface needs no video device
+        const int width = PF::Global::Window::DEFAULT_WIDTH;
+        const int height = PF::Global::Window::DEFAULT_HEIGHT;
+        surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+        if (surface == nullptr) { throw PF::SDLException("Failed to create the render target surface."); }
+        renderer = SDL_CreateSoftwareRenderer(surface);
+        if (renderer == nullptr) { throw PF::SDLException("Failed to create the software renderer."); }
+
+        CheckParticleKernel();
+
+        std::vector<Result> results;
+        for (const auto entities : ENTITY_COUNTS)
+        {
+            if (entities > options.maxEntities) { break; }
+            BenchUpdate(results, entities);
+            BenchSpawnChurn(results, entities);
+            BenchHandleEvent(results, entities);
+            BenchSpatialHash(results, entities);
+            BenchRender(results, entities, renderer);
+        }
+        BenchUpdateScaling(results, std::min(options.maxEntities, ENTITY_COUNTS.back()));
+
+        const std::string json = ToJson(results, PF::EntityStore{}.getParticles().getSimdLevel());
+        if (options.outputPath.empty()) { std::cout << json; }
+        else
+        {
+            std::ofstream output(options.outputPath);
+            output << json;
+            if (!output) { throw PF::Exception(std::format("Failed to write results to {}", options.outputPath)); }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s", e.what());
+        exitCode = 1;
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    return exitCode;
+}
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationTracker.h"
+
+#if PF_ALLOCATION_TRACKING_ENABLED
+namespace
+{
+struct ProcessCounters
+{
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> bytes{0};
+};
+
+// Both are constant-initialized, so they count allocations made before main() and during thread teardown alike
+constinit ProcessCounters g_processCounters;
+constinit thread_local PF::AllocationTracker::AllocationCounts g_threadCounts;
+
+void Count(std::size_t size)
+{
+    g_processCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+    g_processCounters.bytes.fetch_add(size, std::memory_order_relaxed);
+    ++g_threadCounts.allocations;
+    g_threadCounts.bytes += size;
+}
+
+void* AllocateAligned(std::size_t size, std::size_t alignment)
+{
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants a multiple of the alignment, which is a power of two
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+void FreeAligned(void* pointer)
+{
+#ifdef _MSC_VER
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+/**
+ * @brief Allocates like the default operator new: retries through the new handler, throws once there is none.
+ */
+template<typename Allocator>
+void* Allocate(std::size_t size, Allocator&& allocator)
+{
+    Count(size);
+    size = size == 0 ? 1 : size;  // Every allocation must return a distinct pointer
+    for (;;)
+    {
+        if (void* pointer = allocator(size)) { return pointer; }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) { throw std::bad_alloc(); }
+        handler();
+    }
+}
+}  // namespace
+
+// The nothrow and array forms of the default operators forward to these, so they are counted too
+void* operator new(std::size_t size)
+{
+    return Allocate(size, [](std::size_t bytes) { return std::malloc(bytes); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Allocate(size,
+                    [alignment](std::size_t bytes)
+                    { return AllocateAligned(bytes, static_cast<std::size_t>(alignment)); });
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept { FreeAligned(pointer); }
+
+void operator delete(void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    FreeAligned(pointer);
+}
+
+PF::AllocationTracker::AllocationCounts PF::AllocationTracker::getProcessCounts()
+{
+    return {.allocations = g_processCounters.allocations.load(std::memory_order_relaxed),
+            .bytes = g_processCounters.bytes.load(std::memory_order_relaxed)};
+}
+
+PF::AllocationTracker::AllocationCounts PF::AllocationTracker::getThreadCounts() { return g_threadCounts; }
+#else
+PF::AllocationTracker::AllocationCounts PF::AllocationTracker::getProcessCounts() { return {}; }
+
+PF::AllocationTracker::AllocationCounts PF::AllocationTracker::getThreadCounts() { return {}; }
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+#ifndef PF_ALLOCATION_TRACKING_ENABLED
+#define PF_ALLOCATION_TRACKING_ENABLED 0
+#endif
+
+/**
+ * @brief Opt-in heap allocation counters.
+ *
+ * Building with PF_ALLOCATION_TRACKING_ENABLED set to 1 (CMake option PERFECTFORM_ALLOCATION_TRACKING) replaces the
+ * global operator new and delete with versions that count every allocation and its size, both for the whole process
+ * and for the calling thread. Counting is a few relaxed atomic and thread-local additions per allocation, but it still
+ * costs something on every allocation, so it is off by default. Without it every counter reads zero.
+ *
+ * Counters only ever grow: measure a span of code by subtracting the counts taken before it from those taken after.
+ * The profiler does so for each zone, on the zone's thread, the game for each tick, on the simulation thread, and the
+ * headless run for each tick again, on every thread.
+ */
+namespace PF::AllocationTracker
+{
+constexpr bool ENABLED = PF_ALLOCATION_TRACKING_ENABLED != 0;
+
+/**
+ * @struct AllocationCounts
+ * @brief Number of heap allocations, and the bytes they requested.
+ */
+struct AllocationCounts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+
+    [[nodiscard]] AllocationCounts operator-(const AllocationCounts& other) const
+    {
+        return {.allocations = allocations - other.allocations, .bytes = bytes - other.bytes};
+    }
+};
+
+/**
+ * @brief Gets the allocations made by every thread since the start of the process.
+ */
+[[nodiscard]] AllocationCounts getProcessCounts();
+
+/**
+ * @brief Gets the allocations made by the calling thread since it started.
+ */
+[[nodiscard]] AllocationCounts getThreadCounts();
+}  // namespace PF::AllocationTracker
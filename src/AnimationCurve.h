@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+/**
+ * Animation curves evaluated without libm: periodic lookup tables filled at compile time, and a range-reduced sine
+ * polynomial whose degree is a template parameter. Everything is constexpr, so a curve with constant input folds
+ * away entirely, and the tables live in read-only data instead of being built at startup.
+ */
+namespace PF::Animation
+{
+constexpr float PI = std::numbers::pi_v<float>;
+constexpr float HALF_PI = PI / 2.0F;
+constexpr float INV_PI = std::numbers::inv_pi_v<float>;
+
+// pi split in two for range reduction: PI_HI has few enough mantissa bits that q * PI_HI is exact for small q
+constexpr float PI_HI = 3.140625F;
+constexpr float PI_LO = 9.67653589793e-4F;
+
+namespace Detail
+{
+/**
+ * @brief Rounds to the nearest integer, ties to even, like lrintf in the default rounding mode. Exact while
+ * |x| < 2^22, which is far beyond any angle an entity reaches.
+ */
+constexpr float RoundToNearest(const float x)
+{
+    constexpr float SHIFT = 12582912.0F;  // 1.5 * 2^23: adding it pushes the fraction out of the mantissa
+    return (x + SHIFT) - SHIFT;
+}
+
+/**
+ * @brief Reference sine used to fill tables at compile time, accurate to double precision on any input.
+ */
+constexpr double Sine(const double x)
+{
+    constexpr double TWO_PI = 2.0 * std::numbers::pi;
+    auto turns = static_cast<std::int64_t>(x / TWO_PI);
+    double r = x - (static_cast<double>(turns) * TWO_PI);
+    if (r > std::numbers::pi) { r -= TWO_PI; }
+    if (r < -std::numbers::pi) { r += TWO_PI; }
+
+    // Taylor series on [-pi, pi]: the 25th term is already below 1e-16
+    double term = r;
+    double sum = r;
+    for (int n = 3; n <= 51; n += 2)
+    {
+        term *= -(r * r) / static_cast<double>((n - 1) * n);
+        sum += term;
+    }
+    return sum;
+}
+}  // namespace Detail
+
+/**
+ * @struct SinePolynomial
+ * @brief Coefficients of the odd Taylor polynomial of sine, up to x^Degree.
+ *
+ * `COEFFICIENTS[k]` multiplies x^(2k + 3); the linear term is always 1. On the reduced range [-pi/2, pi/2], degree 7
+ * stays within 1.6e-4 of sine, degree 9 within 3.6e-6 and degree 11 within 1.6e-7.
+ */
+template<int Degree>
+struct SinePolynomial
+{
+    static_assert(Degree >= 3 && Degree % 2 == 1, "Sine polynomials are odd, of degree 3 or more");
+
+    static constexpr std::size_t TERMS = (Degree - 1) / 2;
+    static constexpr std::array<float, TERMS> COEFFICIENTS = [] {
+        std::array<float, TERMS> coefficients{};
+        double coefficient = 1.0;
+        for (std::size_t k = 0; k < TERMS; ++k)
+        {
+            const auto power = static_cast<double>((2 * k) + 3);
+            coefficient *= -1.0 / ((power - 1.0) * power);
+            coefficients[k] = static_cast<float>(coefficient);
+        }
+        return coefficients;
+    }();
+};
+
+/**
+ * @brief Sine of `x` radians, from a polynomial of degree `Degree` after reduction to [-pi/2, pi/2].
+ *
+ * The reduction and the Horner evaluation use plain multiplies and adds in the same order as the SIMD attack kernel,
+ * so scalar and vector code agree to the last few ulps.
+ */
+template<int Degree = 9>
+constexpr float sin(const float x)
+{
+    // sin(x) = (-1)^q * sin(x - q * pi), with q = round(x / pi)
+    const float q = Detail::RoundToNearest(x * INV_PI);
+    float r = x - (q * PI_HI);
+    r = r - (q * PI_LO);
+
+    constexpr auto& COEFFICIENTS = SinePolynomial<Degree>::COEFFICIENTS;
+    const float r2 = r * r;
+    float poly = COEFFICIENTS.back();
+    for (std::size_t k = COEFFICIENTS.size() - 1; k > 0; --k) { poly = (poly * r2) + COEFFICIENTS[k - 1]; }
+    const float sine = r + (r * r2 * poly);
+    return (static_cast<std::int32_t>(q) & 1) != 0 ? -sine : sine;
+}
+
+/**
+ * @brief Cosine of `x` radians, as the sine polynomial shifted by a quarter turn.
+ */
+template<int Degree = 9>
+constexpr float cos(const float x)
+{
+    return PF::Animation::sin<Degree>(x + HALF_PI);
+}
+
+/**
+ * @class PeriodicTable
+ * @brief A curve with a period of 1, sampled `Size` times at compile time and read back with linear interpolation.
+ *
+ * A lookup costs one multiply, a mask and a lerp whatever the curve, so it suits cosmetic effects where an error of
+ * (period / Size)^2 / 8 times the curve's second derivative is invisible. Size must be a power of two so wrapping the
+ * phase is a mask.
+ *
+ * @tparam Size The number of samples per period.
+ * @tparam T The floating-point type the samples are stored and interpolated in.
+ */
+template<std::size_t Size, std::floating_point T = float>
+class PeriodicTable
+{
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Table size must be a power of two");
+
+  public:
+    /**
+     * @param curve A constexpr callable mapping a phase in [0, 1) to the curve value, evaluated in double.
+     */
+    template<typename Curve>
+    constexpr explicit PeriodicTable(Curve curve)
+    {
+        for (std::size_t i = 0; i <= Size; ++i)
+        {
+            m_samples[i] = static_cast<T>(curve(static_cast<double>(i) / static_cast<double>(Size)));
+        }
+    }
+
+    /**
+     * @brief Evaluates the curve at `phase`, in periods. Any value is accepted, it wraps around.
+     */
+    constexpr T operator()(const T phase) const
+    {
+        const T scaled = phase * static_cast<T>(Size);
+        auto whole = static_cast<std::int64_t>(scaled);
+        if (static_cast<T>(whole) > scaled) { --whole; }  // Floor, also for negative phases
+
+        const T fraction = scaled - static_cast<T>(whole);
+        const auto index = static_cast<std::size_t>(whole) & (Size - 1);
+        return m_samples[index] + ((m_samples[index + 1] - m_samples[index]) * fraction);
+    }
+
+  private:
+    std::array<T, Size + 1> m_samples{};  // One extra sample, equal to the first, so interpolation never wraps
+};
+
+/**
+ * @brief One period of sine, for any table size and precision.
+ */
+template<std::size_t Size, std::floating_point T = float>
+inline constexpr PeriodicTable<Size, T> SINE_TABLE{
+    [](double phase) { return PF::Animation::Detail::Sine(phase * 2.0 * std::numbers::pi); }};
+
+/**
+ * @brief Sine of `x` radians, read from a `Size` entry table. With 256 entries the error stays below 8e-5.
+ */
+template<std::size_t Size, std::floating_point T = float>
+constexpr T sinTable(const T x)
+{
+    return SINE_TABLE<Size, T>(x * std::numbers::inv_pi_v<T> / static_cast<T>(2));
+}
+
+static_assert(SinePolynomial<9>::COEFFICIENTS[0] == -1.0F / 6.0F, "Sine polynomial coefficients are wrong");
+static_assert(PF::Animation::sin(HALF_PI) > 0.99999F && PF::Animation::sin(HALF_PI) < 1.00001F, "Sine is wrong");
+static_assert(SINE_TABLE<256>(0.25F) > 0.99999F, "Sine table is wrong");
+}  // namespace PF::Animation
@@ -0,0 +1,176 @@
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AssetPack.h"
+#include "Exceptions.h"
+
+namespace
+{
+/**
+ * @brief Maps a whole file read-only.
+ * @throws PF::Exception if the file cannot be opened or mapped.
+ */
+std::pair<const std::byte*, std::size_t> MapFile(std::string_view filePath)
+{
+    const std::string path{filePath};
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { throw PF::Exception(std::format("Couldn't open asset pack: {}", filePath)); }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw PF::Exception(std::format("Couldn't get the size of asset pack: {}", filePath));
+    }
+
+    // The view keeps the mapping alive, so both handles can be closed right away
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) { throw PF::Exception(std::format("Couldn't map asset pack: {}", filePath)); }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) { throw PF::Exception(std::format("Couldn't map asset pack: {}", filePath)); }
+
+    return {static_cast<const std::byte*>(data), static_cast<std::size_t>(fileSize.QuadPart)};
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) { throw PF::Exception(std::format("Couldn't open asset pack: {}", filePath)); }
+
+    struct stat fileStat = {};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(file);
+        throw PF::Exception(std::format("Couldn't get the size of asset pack: {}", filePath));
+    }
+
+    // The mapping outlives the descriptor, so it can be closed right away
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) { throw PF::Exception(std::format("Couldn't map asset pack: {}", filePath)); }
+
+    return {static_cast<const std::byte*>(data), size};
+#endif
+}
+
+void UnmapFile(const std::byte* data, [[maybe_unused]] std::size_t size)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<std::byte*>(data), size);
+#endif
+}
+}  // namespace
+
+PF::AssetPack::AssetPack(std::string_view filePath)
+{
+    namespace Format = PF::AssetPackFormat;
+
+    std::tie(m_data, m_size) = MapFile(filePath);
+    try
+    {
+        // Header and index are copied out rather than cast, the pixels are the only thing used in place
+        Format::Header header;
+        if (m_size < sizeof(header)) { throw PF::Exception(std::format("Truncated asset pack: {}", filePath)); }
+        std::memcpy(&header, m_data, sizeof(header));
+        if (header.magic != Format::MAGIC || header.version != Format::VERSION)
+        {
+            throw PF::Exception(std::format("Not an asset pack, or an unsupported version: {}", filePath));
+        }
+        if ((m_size - sizeof(header)) / sizeof(Format::Entry) < header.entryCount)
+        {
+            throw PF::Exception(std::format("Truncated asset pack index: {}", filePath));
+        }
+
+        m_images.reserve(header.entryCount);
+        for (std::uint32_t i = 0; i < header.entryCount; ++i)
+        {
+            Format::Entry entry;
+            std::memcpy(&entry, m_data + sizeof(header) + (i * sizeof(entry)), sizeof(entry));
+
+            const bool inBounds = entry.offset <= m_size && entry.size <= m_size - entry.offset;
+            const std::uint64_t rowSize =
+                static_cast<std::uint64_t>(entry.width) * SDL_BYTESPERPIXEL(Format::PIXEL_FORMAT);
+            const bool consistent =
+                entry.pitch >= rowSize && static_cast<std::uint64_t>(entry.pitch) * entry.height <= entry.size;
+            if (!inBounds || !consistent || entry.format != static_cast<std::uint32_t>(Format::PIXEL_FORMAT) ||
+                entry.name.back() != '\0')
+            {
+                throw PF::Exception(std::format("Corrupted entry {} in asset pack: {}", i, filePath));
+            }
+
+            // Names live in the mapping too, so the views stay valid as long as the pack
+            const auto* name = reinterpret_cast<const char*>(m_data + sizeof(header) + (i * sizeof(entry)));
+            m_images.push_back({.name = std::string_view{name},
+                                .width = static_cast<int>(entry.width),
+                                .height = static_cast<int>(entry.height),
+                                .pitch = static_cast<int>(entry.pitch),
+                                .pixels = m_data + entry.offset});
+        }
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+PF::AssetPack::AssetPack(AssetPack&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+      m_images(std::move(other.m_images))
+{
+}
+
+PF::AssetPack& PF::AssetPack::operator=(AssetPack&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_images = std::move(other.m_images);
+    }
+    return *this;
+}
+
+PF::AssetPack::~AssetPack() { unmap(); }
+
+const PF::AssetPack::Image* PF::AssetPack::find(std::string_view name) const
+{
+    // Packs hold a handful of images per level, a linear scan beats building a hash map
+    for (const Image& image : m_images)
+    {
+        if (image.name == name) { return &image; }
+    }
+    return nullptr;
+}
+
+const std::vector<PF::AssetPack::Image>& PF::AssetPack::getImages() const { return m_images; }
+
+void PF::AssetPack::unmap()
+{
+    if (m_data != nullptr) { UnmapFile(m_data, m_size); }
+    m_data = nullptr;
+    m_size = 0;
+    m_images.clear();
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace PF
+{
+/**
+ * @brief On-disk layout of an asset pack, shared by the game and the offline packer.
+ *
+ * A pack is a Header, followed by `entryCount` Entry records, followed by the pixel blocks they point to. Every
+ * block starts on a DATA_ALIGNMENT boundary. Integers are stored little-endian.
+ */
+namespace AssetPackFormat
+{
+constexpr std::array<char, 4> MAGIC = {'P', 'F', 'P', 'K'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t NAME_SIZE = 64;       // Fixed size of an entry name, including the terminating zero
+constexpr std::size_t DATA_ALIGNMENT = 64;  // Alignment of every pixel block, from the start of the file
+
+// Format of the pixels: the one of the atlas pages, so they are uploaded without conversion
+constexpr SDL_PixelFormat PIXEL_FORMAT = SDL_PIXELFORMAT_RGBA32;
+
+struct Header
+{
+    std::array<char, 4> magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t entryCount = 0;
+    std::uint32_t reserved = 0;
+};
+
+struct Entry
+{
+    std::array<char, NAME_SIZE> name = {};  // File name of the source image, e.g. "BaseCell_64x64.png"
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint32_t pitch = 0;   // Bytes between two rows
+    std::uint32_t format = 0;  // SDL_PixelFormat of the pixels
+    std::uint64_t offset = 0;  // Start of the pixels, from the start of the file
+    std::uint64_t size = 0;    // Size of the pixels, in bytes
+};
+
+static_assert(sizeof(Header) == 16, "Asset pack header layout changed");
+static_assert(sizeof(Entry) == 96, "Asset pack entry layout changed");
+}  // namespace AssetPackFormat
+
+/**
+ * @class AssetPack
+ * @brief Read-only view of an asset pack file, mapped into memory.
+ *
+ * The file is mapped rather than read, so opening a pack costs the same whatever its size, and the pixels handed out
+ * point straight into the mapping: the operating system pages them in when they are first uploaded.
+ */
+class AssetPack
+{
+  public:
+    /**
+     * @struct Image
+     * @brief Pre-converted pixels of one image, pointing into the mapped file.
+     */
+    struct Image
+    {
+        std::string_view name;
+        int width = 0;
+        int height = 0;
+        int pitch = 0;
+        const void* pixels = nullptr;
+    };
+
+    /**
+     * @brief Maps a pack file and checks its index.
+     * @param filePath The path to the pack file.
+     * @throws PF::Exception if the file cannot be mapped or is not a valid pack.
+     */
+    explicit AssetPack(std::string_view filePath);
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    AssetPack(AssetPack&& other) noexcept;
+    AssetPack& operator=(AssetPack&& other) noexcept;
+    ~AssetPack();
+
+    /**
+     * @brief Looks an image up by file name.
+     * @return The image, or nullptr if the pack does not contain it.
+     */
+    [[nodiscard]] const Image* find(std::string_view name) const;
+
+    [[nodiscard]] const std::vector<Image>& getImages() const;
+
+  private:
+    void unmap();
+
+  private:
+    const std::byte* m_data = nullptr;  // Start of the mapping
+    std::size_t m_size = 0;             // Size of the mapping, in bytes
+    std::vector<Image> m_images;        // Index of the pack, names and pixels pointing into the mapping
+};
+}  // namespace PF
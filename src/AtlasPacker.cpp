@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <optional>
+
+#include "AtlasPacker.h"
+
+PF::AtlasPacker::AtlasPacker(int width, int height): m_width(width), m_height(height)
+{
+    assert(width > 0 && height > 0 && "Atlas pages must not be empty.");
+    m_skyline.push_back({.x = 0, .y = 0, .width = width});
+}
+
+std::optional<SDL_Rect> PF::AtlasPacker::insert(int width, int height)
+{
+    if (width <= 0 || height <= 0) { return std::nullopt; }
+
+    // Pick the segment where the rectangle's top edge ends lowest, then the one leaving the narrowest step
+    std::size_t bestIndex = m_skyline.size();
+    int bestBottom = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        const auto y = fit(i, width, height);
+        if (!y) { continue; }
+
+        const int bottom = *y + height;
+        if (bottom < bestBottom || (bottom == bestBottom && m_skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestBottom = bottom;
+            bestWidth = m_skyline[i].width;
+            bestY = *y;
+        }
+    }
+    if (bestIndex == m_skyline.size()) { return std::nullopt; }
+
+    const SDL_Rect placed = {m_skyline[bestIndex].x, bestY, width, height};
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex),
+                     {.x = placed.x, .y = placed.y + height, .width = width});
+
+    // Trim the segments now hidden under the new one
+    const int right = placed.x + width;
+    for (std::size_t i = bestIndex + 1; i < m_skyline.size();)
+    {
+        Segment& segment = m_skyline[i];
+        if (segment.x >= right) { break; }
+
+        const int overlap = right - segment.x;
+        if (overlap < segment.width)
+        {
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    // Merge neighbours at the same height
+    for (std::size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            continue;
+        }
+        ++i;
+    }
+
+    m_usedArea += static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    return placed;
+}
+
+std::optional<int> PF::AtlasPacker::fit(std::size_t index, int width, int height) const
+{
+    if (m_skyline[index].x + width > m_width) { return std::nullopt; }
+
+    // The rectangle rests on the highest segment it spans
+    int y = 0;
+    int remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i)
+    {
+        assert(i < m_skyline.size());
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) { return std::nullopt; }
+        remaining -= m_skyline[i].width;
+    }
+    return y;
+}
+
+int PF::AtlasPacker::getWidth() const { return m_width; }
+
+int PF::AtlasPacker::getHeight() const { return m_height; }
+
+std::size_t PF::AtlasPacker::getUsedArea() const { return m_usedArea; }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace PF
+{
+/**
+ * @class AtlasPacker
+ * @brief Places rectangles inside a fixed-size page without overlap, using a skyline bottom-left heuristic.
+ *
+ * The packer tracks the top edge of the used area as a list of horizontal segments. Each rectangle goes where its top
+ * edge ends lowest, which keeps the free space in one piece for sprite-sized images. Rectangles are never removed.
+ */
+class AtlasPacker
+{
+  public:
+    /**
+     * @param width The page width, in pixels.
+     * @param height The page height, in pixels.
+     */
+    AtlasPacker(int width, int height);
+
+    /**
+     * @brief Finds room for a rectangle and marks it used.
+     * @return The placed rectangle, or std::nullopt if the page has no room left for it.
+     */
+    std::optional<SDL_Rect> insert(int width, int height);
+
+    [[nodiscard]] int getWidth() const;
+    [[nodiscard]] int getHeight() const;
+
+    /**
+     * @brief Gets the number of pixels covered by the inserted rectangles.
+     */
+    [[nodiscard]] std::size_t getUsedArea() const;
+
+  private:
+    struct Segment
+    {
+        int x = 0;
+        int y = 0;  // Top of the used area below this segment
+        int width = 0;
+    };
+
+    /**
+     * @brief Gets the lowest y a rectangle starting at segment `index` can sit at, or std::nullopt if it does not fit.
+     */
+    [[nodiscard]] std::optional<int> fit(std::size_t index, int width, int height) const;
+
+  private:
+    int m_width;
+    int m_height;
+    std::size_t m_usedArea = 0;
+    std::vector<Segment> m_skyline;  // Left to right, covering the whole page width
+};
+}  // namespace PF
@@ -0,0 +1,34 @@
+#include <cstddef>
+
+#include "Attack.h"
+#include "Enums.h"
+#include "GlobalDefinitions.h"
+#include "ParticleKernel.h"
+
+constexpr float ATTACK_VELOCITY_MULTIPLIER = 2.0F;
+constexpr float ATTACK_VELOCITY_JITTER_MIN = 0.6F;  // Each axis keeps between 60% and 100% of its speed
+constexpr float ATTACK_VELOCITY_JITTER_RANGE = 0.4F;
+constexpr float ATTACK_SIZE_FACTOR = 0.3333F;
+constexpr float MIN_ATTACK_SIZE = 0.02F;
+
+constexpr PF::ParticleMotion ATTACK_MOTION = {.angleIncrement = 0.005F,
+                                              .deceleration = 0.025F,
+                                              .cosAngleMultiplier = 1.33F,
+                                              .wobble = 0.5F,
+                                              .sizeOscillation = 0.005F,
+                                              .sizeOscillationMultiplier = 3.0F,
+                                              .sizeDecay = 0.00005F};
+
+PF::EmitterConfig PF::Attack::makeEmitterConfig(std::size_t textureIdx, SDL_FRect srcRect)
+{
+    return {.textureIdx = textureIdx,
+            .srcRect = srcRect,
+            .capacity = PF::Global::Model::MAX_ATTACK_COUNT,
+            .overflowPolicy = PF::PoolOverflowPolicy::RECYCLE_OLDEST,
+            .motion = ATTACK_MOTION,
+            .speedMultiplier = ATTACK_VELOCITY_MULTIPLIER,
+            .speedJitterMin = ATTACK_VELOCITY_JITTER_MIN,
+            .speedJitterRange = ATTACK_VELOCITY_JITTER_RANGE,
+            .sizeFactor = ATTACK_SIZE_FACTOR,
+            .minSize = MIN_ATTACK_SIZE};
+}
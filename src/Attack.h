@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+
+#include "ParticleEmitter.h"
+
+namespace PF::Attack
+{
+/**
+ * @brief Describes the projectiles players fire, as particles.
+ *
+ * Attacks leave along the player's velocity, twice as fast and jittered per axis, at a third of the player's size.
+ * They drift while wobbling, decelerate until they stop, and shrink until they are removed. The pool holds
+ * MAX_ATTACK_COUNT attacks and recycles the oldest one when full.
+ *
+ * @param textureIdx The atlas handle attacks are drawn with, usually the one of the players firing them.
+ * @param srcRect The source rectangle inside the texture.
+ */
+[[nodiscard]] PF::EmitterConfig makeEmitterConfig(std::size_t textureIdx, SDL_FRect srcRect);
+}  // namespace PF::Attack
@@ -0,0 +1,59 @@
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+#include "AnimationCurve.h"
+#include "Camera.h"
+
+constexpr float DEGREES_TO_RADIANS = std::numbers::pi_v<float> / 180.0F;
+
+PF::Camera::Camera(SDL_FPoint viewportSize, SDL_FPoint position): m_viewportSize(viewportSize), m_position(position) {}
+
+SDL_FPoint PF::Camera::getPosition() const { return m_position; }
+
+void PF::Camera::setViewportSize(SDL_FPoint viewportSize) { m_viewportSize = viewportSize; }
+
+SDL_FPoint PF::Camera::getViewportSize() const { return m_viewportSize; }
+
+void PF::Camera::setRetireMargin(std::optional<float> retireMargin) { m_retireMargin = retireMargin; }
+
+std::optional<float> PF::Camera::getRetireMargin() const { return m_retireMargin; }
+
+SDL_FPoint PF::Camera::worldToScreen(SDL_FPoint world) const
+{
+    return {world.x - m_position.x + (m_viewportSize.x / 2), world.y - m_position.y + (m_viewportSize.y / 2)};
+}
+
+SDL_FRect PF::Camera::worldToScreen(const SDL_FRect& world) const
+{
+    const SDL_FPoint topLeft = worldToScreen(SDL_FPoint{world.x, world.y});
+    return {topLeft.x, topLeft.y, world.w, world.h};
+}
+
+SDL_FRect PF::Camera::getVisibleArea(float margin) const
+{
+    const float halfWidth = (m_viewportSize.x / 2) + margin;
+    const float halfHeight = (m_viewportSize.y / 2) + margin;
+    return {m_position.x - halfWidth, m_position.y - halfHeight, halfWidth * 2, halfHeight * 2};
+}
+
+bool PF::Camera::isVisible(const SDL_FRect& world) const
+{
+    const SDL_FRect visible = getVisibleArea();
+    return world.x < visible.x + visible.w && visible.x < world.x + world.w && world.y < visible.y + visible.h &&
+           visible.y < world.y + world.h;
+}
+
+bool PF::Camera::isVisible(const SDL_FRect& world, float angle) const
+{
+    if (angle == 0.0F) { return isVisible(world); }
+
+    // The box around the rotated sprite, about the same centre
+    const float radians = angle * DEGREES_TO_RADIANS;
+    const float cosAngle = std::fabs(PF::Animation::cos(radians));
+    const float sinAngle = std::fabs(PF::Animation::sin(radians));
+    const float width = (world.w * cosAngle) + (world.h * sinAngle);
+    const float height = (world.w * sinAngle) + (world.h * cosAngle);
+    const SDL_FPoint centre = {world.x + (world.w / 2), world.y + (world.h / 2)};
+    return isVisible({centre.x - (width / 2), centre.y - (height / 2), width, height});
+}
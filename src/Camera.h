@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <optional>
+
+namespace PF
+{
+/**
+ * @class Camera
+ * @brief Maps world coordinates to the screen and tells which parts of the world are visible.
+ *
+ * The camera looks at a world position, which ends up in the centre of the viewport, one world unit to a pixel.
+ * Entities live in world coordinates, so they no longer depend on the window size.
+ */
+class Camera
+{
+  public:
+    /**
+     * @param viewportSize The size of the area rendered to, in pixels.
+     * @param position The world position shown in the centre of the viewport.
+     */
+    Camera(SDL_FPoint viewportSize, SDL_FPoint position);
+
+    [[nodiscard]] SDL_FPoint getPosition() const;
+
+    void setViewportSize(SDL_FPoint viewportSize);
+    [[nodiscard]] SDL_FPoint getViewportSize() const;
+
+    /**
+     * @brief Sets how far outside the visible area, in world units, projectiles survive. std::nullopt, the default of
+     * a new camera, keeps them forever.
+     */
+    void setRetireMargin(std::optional<float> retireMargin);
+    [[nodiscard]] std::optional<float> getRetireMargin() const;
+
+    [[nodiscard]] SDL_FPoint worldToScreen(SDL_FPoint world) const;
+    [[nodiscard]] SDL_FRect worldToScreen(const SDL_FRect& world) const;
+
+    /**
+     * @brief Gets the world area covered by the viewport, grown by `margin` world units on every side.
+     */
+    [[nodiscard]] SDL_FRect getVisibleArea(float margin = 0.0F) const;
+
+    /**
+     * @brief Checks whether a world-space box touches the viewport.
+     */
+    [[nodiscard]] bool isVisible(const SDL_FRect& world) const;
+
+    /**
+     * @brief Checks whether a world-space box, drawn rotated by `angle` degrees about its centre, touches the viewport.
+     */
+    [[nodiscard]] bool isVisible(const SDL_FRect& world, float angle) const;
+
+  private:
+    SDL_FPoint m_viewportSize;
+    SDL_FPoint m_position;
+    std::optional<float> m_retireMargin;  // Distance beyond the visible area where projectiles are retired
+};
+}  // namespace PF
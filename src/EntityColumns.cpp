@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "EntityColumns.h"
+
+std::size_t PF::EntityColumns::push(
+    std::size_t texture, SDL_FRect source, SDL_FPoint position, float scale, Uint64 seed)
+{
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    previousX.push_back(position.x);
+    previousY.push_back(position.y);
+    velocityX.push_back(0.0F);
+    velocityY.push_back(0.0F);
+    size.push_back(scale);
+    angle.push_back(0.0F);
+    textureIdx.push_back(texture);
+    srcRect.push_back(source);
+    randomState.push_back(seed);
+    return count() - 1;
+}
+
+void PF::EntityColumns::moveEntity(std::size_t from, std::size_t to)
+{
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    previousX[to] = previousX[from];
+    previousY[to] = previousY[from];
+    velocityX[to] = velocityX[from];
+    velocityY[to] = velocityY[from];
+    size[to] = size[from];
+    angle[to] = angle[from];
+    textureIdx[to] = textureIdx[from];
+    srcRect[to] = srcRect[from];
+    randomState[to] = randomState[from];
+}
+
+namespace
+{
+template<typename T>
+void EraseFront(std::vector<T>& column, std::size_t count)
+{
+    std::move(column.begin() + static_cast<std::ptrdiff_t>(count), column.end(), column.begin());
+    column.resize(column.size() - count);
+}
+}  // namespace
+
+void PF::EntityColumns::removeFront(std::size_t count)
+{
+    count = std::min(count, this->count());
+    EraseFront(positionX, count);
+    EraseFront(positionY, count);
+    EraseFront(previousX, count);
+    EraseFront(previousY, count);
+    EraseFront(velocityX, count);
+    EraseFront(velocityY, count);
+    EraseFront(size, count);
+    EraseFront(angle, count);
+    EraseFront(textureIdx, count);
+    EraseFront(srcRect, count);
+    EraseFront(randomState, count);
+}
+
+void PF::EntityColumns::truncate(std::size_t count)
+{
+    // Shrinking never reallocates, so the reserved capacity is kept for the next spawns
+    positionX.resize(count);
+    positionY.resize(count);
+    previousX.resize(count);
+    previousY.resize(count);
+    velocityX.resize(count);
+    velocityY.resize(count);
+    size.resize(count);
+    angle.resize(count);
+    textureIdx.resize(count);
+    srcRect.resize(count);
+    randomState.resize(count);
+}
+
+void PF::EntityColumns::reserve(std::size_t capacity)
+{
+    positionX.reserve(capacity);
+    positionY.reserve(capacity);
+    previousX.reserve(capacity);
+    previousY.reserve(capacity);
+    velocityX.reserve(capacity);
+    velocityY.reserve(capacity);
+    size.reserve(capacity);
+    angle.reserve(capacity);
+    textureIdx.reserve(capacity);
+    srcRect.reserve(capacity);
+    randomState.reserve(capacity);
+}
+
+void PF::EntityColumns::clear() { truncate(0); }
+
+void PF::EntityColumns::storePreviousPositions(std::size_t begin, std::size_t end)
+{
+    std::copy(positionX.begin() + static_cast<std::ptrdiff_t>(begin),
+              positionX.begin() + static_cast<std::ptrdiff_t>(end),
+              previousX.begin() + static_cast<std::ptrdiff_t>(begin));
+    std::copy(positionY.begin() + static_cast<std::ptrdiff_t>(begin),
+              positionY.begin() + static_cast<std::ptrdiff_t>(end),
+              previousY.begin() + static_cast<std::ptrdiff_t>(begin));
+}
+
+std::size_t PF::EntityColumns::count() const { return positionX.size(); }
+
+std::size_t PF::EntityColumns::capacity() const { return positionX.capacity(); }
+
+SDL_FRect PF::EntityColumns::dstRect(std::size_t index) const
+{
+    const auto width = srcRect[index].w * size[index];
+    const auto height = srcRect[index].h * size[index];
+    return {(positionX[index] - (width / 2)), (positionY[index] - (height / 2)), width, height};
+}
+
+SDL_FRect PF::EntityColumns::dstRect(std::size_t index, float alpha) const
+{
+    const auto width = srcRect[index].w * size[index];
+    const auto height = srcRect[index].h * size[index];
+    const float x = previousX[index] + ((positionX[index] - previousX[index]) * alpha);
+    const float y = previousY[index] + ((positionY[index] - previousY[index]) * alpha);
+    return {(x - (width / 2)), (y - (height / 2)), width, height};
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace PF
+{
+/**
+ * @struct EntityColumns
+ * @brief Structure-of-arrays storage for the data every entity kind shares.
+ *
+ * Each attribute lives in its own contiguous column, and index i across all columns describes the same entity.
+ * Update and render passes walk the columns linearly instead of chasing one heap block per entity.
+ */
+struct EntityColumns
+{
+    std::vector<float> positionX;         /**< World x coordinate of the entity centre. */
+    std::vector<float> positionY;         /**< World y coordinate of the entity centre. */
+    std::vector<float> previousX;         /**< positionX before the last step, to interpolate rendering. */
+    std::vector<float> previousY;         /**< positionY before the last step, to interpolate rendering. */
+    std::vector<float> velocityX;         /**< Horizontal velocity in pixels per step. */
+    std::vector<float> velocityY;         /**< Vertical velocity in pixels per step. */
+    std::vector<float> size;              /**< Scale applied to the source rectangle. */
+    std::vector<float> angle;             /**< Animation angle, also used as rotation by some kinds. */
+    std::vector<std::size_t> textureIdx;  /**< Atlas handle in the TextureManager. */
+    std::vector<SDL_FRect> srcRect;       /**< Source rectangle inside the texture. */
+    std::vector<Uint64> randomState;      /**< Private state for SDL_randf_r, so entities can update on any thread. */
+
+    /**
+     * @brief Appends an entity with zero velocity and angle.
+     * @param seed The initial state of the entity's random generator.
+     * @return The index of the new entity.
+     */
+    std::size_t push(std::size_t texture, SDL_FRect source, SDL_FPoint position, float scale, Uint64 seed);
+
+    /**
+     * @brief Copies every column of entity `from` into slot `to`. Used by stable compaction.
+     */
+    void moveEntity(std::size_t from, std::size_t to);
+
+    /**
+     * @brief Drops the first `count` entities, sliding the rest down in order.
+     */
+    void removeFront(std::size_t count);
+
+    /**
+     * @brief Drops every entity at or after `count`.
+     */
+    void truncate(std::size_t count);
+
+    void reserve(std::size_t capacity);
+    void clear();
+
+    /**
+     * @brief Saves the current position of entities [begin, end) as their previous one. Called before each step.
+     */
+    void storePreviousPositions(std::size_t begin, std::size_t end);
+
+    [[nodiscard]] std::size_t count() const;
+    [[nodiscard]] std::size_t capacity() const;
+
+    /**
+     * @brief Computes the destination rectangle of an entity, centred on its position.
+     */
+    [[nodiscard]] SDL_FRect dstRect(std::size_t index) const;
+
+    /**
+     * @brief Computes the destination rectangle of an entity, centred between its previous and current positions.
+     * @param alpha How far into the step to draw, 0 for the previous position and 1 for the current one.
+     */
+    [[nodiscard]] SDL_FRect dstRect(std::size_t index, float alpha) const;
+};
+}  // namespace PF
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "EntityColumns.h"
+#include "Enums.h"
+
+namespace PF
+{
+class Camera;
+class JobSystem;
+struct RenderSnapshot;
+
+/**
+ * @brief What a store must provide to be one of the entity kinds of an EntityRegistry.
+ *
+ * A store owns every entity of one concrete kind, and each of these calls runs over all of them at once, so a pass
+ * over a kind is a plain loop the compiler sees in full: no virtual call or type switch per entity.
+ */
+template<typename Store>
+concept EntityKindStore = requires(Store& store,
+                                   const Store& constStore,
+                                   Uint64 stepMs,
+                                   PF::JobSystem& jobSystem,
+                                   PF::RenderSnapshot& snapshot,
+                                   const PF::Camera& camera) {
+    { Store::KIND } -> std::convertible_to<PF::EntityKind>;
+    store.update(stepMs, jobSystem);
+    store.removeExpired();
+    constStore.capture(snapshot, camera);
+    { constStore.count() } -> std::convertible_to<std::size_t>;
+    { constStore.getColumns() } -> std::same_as<const PF::EntityColumns&>;
+};
+
+namespace Detail
+{
+template<std::size_t N>
+constexpr bool HasDistinctKinds(const std::array<PF::EntityKind, N>& kinds)
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = i + 1; j < N; ++j)
+        {
+            if (kinds[i] == kinds[j]) { return false; }
+        }
+    }
+    return true;
+}
+}  // namespace Detail
+
+/**
+ * @class EntityRegistry
+ * @brief Keeps one store per entity kind, and runs passes over all of them kind by kind.
+ *
+ * The kinds are fixed at compile time, so forEach() unrolls into one direct call per store. They are visited in the
+ * order they are listed, which is also the update and draw order.
+ *
+ * @tparam Stores The stores of every kind, each satisfying EntityKindStore with a distinct KIND.
+ */
+template<PF::EntityKindStore... Stores>
+class EntityRegistry
+{
+  public:
+    static constexpr std::size_t KIND_COUNT = sizeof...(Stores);
+
+    /**
+     * @brief Gets the store of a kind by type.
+     */
+    template<typename Store>
+    [[nodiscard]] Store& get()
+    {
+        return std::get<Store>(m_stores);
+    }
+
+    template<typename Store>
+    [[nodiscard]] const Store& get() const
+    {
+        return std::get<Store>(m_stores);
+    }
+
+    /**
+     * @brief Calls `visitor` with every store, in registration order.
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor)
+    {
+        std::apply([&](Stores&... stores) { (visitor(stores), ...); }, m_stores);
+    }
+
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        std::apply([&](const Stores&... stores) { (visitor(stores), ...); }, m_stores);
+    }
+
+    /**
+     * @brief Gets the number of live entities, summed over every kind.
+     */
+    [[nodiscard]] std::size_t count() const
+    {
+        return std::apply([](const Stores&... stores) { return (std::size_t{0} + ... + stores.count()); }, m_stores);
+    }
+
+  private:
+    static_assert(KIND_COUNT > 0, "A registry needs at least one entity kind");
+    static_assert(PF::Detail::HasDistinctKinds(std::array<PF::EntityKind, KIND_COUNT>{Stores::KIND...}),
+                  "Every store of a registry must hold a different entity kind");
+
+    std::tuple<Stores...> m_stores;
+};
+}  // namespace PF
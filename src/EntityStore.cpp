@@ -0,0 +1,42 @@
+#include <cstddef>
+
+#include "EntityStore.h"
+#include "RenderSnapshot.h"
+
+void PF::EntityStore::update(Uint64 stepMs, PF::JobSystem& jobSystem)
+{
+    // Update all entities, kind by kind, then the particles
+    m_kinds.forEach([&](auto& store) { store.update(stepMs, jobSystem); });
+    m_particles.update(stepMs, jobSystem);
+
+    // Remove entities and particles that should be removed after updating
+    m_kinds.forEach([](auto& store) { store.removeExpired(); });
+    m_particles.removeExpired();
+
+    // Emit new particles based on the current entities
+    getPlayers().spawnAttacks(m_particles);
+}
+
+void PF::EntityStore::handleEvent(PF::PlayerIntention playerIntention) { getPlayers().handleEvent(playerIntention); }
+
+void PF::EntityStore::capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const
+{
+    // Kinds listed later are drawn over earlier ones, and particles over every entity, e.g. the players firing them
+    m_kinds.forEach(
+        [&](const auto& store)
+        {
+            snapshot.entityCounts[static_cast<std::size_t>(store.KIND)] = store.count();
+            store.capture(snapshot, camera);
+        });
+    m_particles.capture(snapshot, camera);
+}
+
+PF::PlayerStore& PF::EntityStore::getPlayers() { return m_kinds.get<PF::PlayerStore>(); }
+
+const PF::PlayerStore& PF::EntityStore::getPlayers() const { return m_kinds.get<PF::PlayerStore>(); }
+
+PF::ParticleSystem& PF::EntityStore::getParticles() { return m_particles; }
+
+const PF::ParticleSystem& PF::EntityStore::getParticles() const { return m_particles; }
+
+std::size_t PF::EntityStore::count() const { return m_kinds.count() + m_particles.count(); }
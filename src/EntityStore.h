@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <utility>
+
+#include "EntityRegistry.h"
+#include "Enums.h"
+#include "ParticleSystem.h"
+#include "Player.h"
+
+namespace PF
+{
+class Camera;
+class JobSystem;
+struct RenderSnapshot;
+
+/**
+ * @brief Every entity kind of the game, in update and draw order.
+ *
+ * To add a kind: write its store so it satisfies EntityKindStore, give it a new EntityKind value, and list it here.
+ * Updating, expiring, drawing, counting and the spatial hash then pick it up. Only interactions between kinds, such as
+ * players spawning attacks, are spelled out in EntityStore::update().
+ */
+using EntityKinds = PF::EntityRegistry<PF::PlayerStore>;
+
+/**
+ * @class EntityStore
+ * @brief Data-oriented storage for every entity in the game, grouped by entity kind.
+ *
+ * Each kind keeps its data in contiguous columns, so a tick is a handful of linear passes instead of one virtual
+ * call and one pointer chase per entity. Short-lived effects such as attacks are not entities but particles, emitted
+ * by the entities their emitters are attached to. The spatial hash indexes them alongside the entities, as PARTICLE.
+ */
+class EntityStore
+{
+  public:
+    /**
+     * @brief Advances every entity and particle by one simulation step, then removes expired ones and spawns new ones.
+     *
+     * The per-entity update is spread over the job system. Removal and spawning then run on the calling thread in
+     * entity order, so the outcome of a tick does not depend on the number of threads.
+     *
+     * @param stepMs The simulation step in milliseconds.
+     * @param jobSystem The job system running the parallel passes.
+     */
+    void update(Uint64 stepMs, PF::JobSystem& jobSystem);
+
+    void handleEvent(PF::PlayerIntention playerIntention);
+
+    /**
+     * @brief Appends a sprite to `snapshot` for every entity the camera sees, kind by kind, then the particles, and
+     * their counts.
+     */
+    void capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const;
+
+    [[nodiscard]] PF::PlayerStore& getPlayers();
+    [[nodiscard]] const PF::PlayerStore& getPlayers() const;
+    [[nodiscard]] PF::ParticleSystem& getParticles();
+    [[nodiscard]] const PF::ParticleSystem& getParticles() const;
+
+    /**
+     * @brief Calls `visitor` with the store of every entity kind, in update and draw order.
+     */
+    template<typename Visitor>
+    void forEachKind(Visitor&& visitor) const
+    {
+        m_kinds.forEach(std::forward<Visitor>(visitor));
+    }
+
+    /**
+     * @brief Gets the total number of live entities across every kind, particles included.
+     */
+    [[nodiscard]] std::size_t count() const;
+
+  private:
+    PF::EntityKinds m_kinds;         // One store per entity kind
+    PF::ParticleSystem m_particles;  // Emitters attached to the entities
+};
+}  // namespace PF
@@ -19,3 +19,51 @@ const char* PF::toString(const PF::PlayerIntention playerIntention)
     }
     return nullptr;
 }
+
+const char* PF::toString(const PF::EntityKind entityKind)
+{
+    switch (entityKind)
+    {
+        case PF::EntityKind::PLAYER: return "PLAYER";
+        case PF::EntityKind::PARTICLE: return "PARTICLE";
+        case PF::EntityKind::EntityKind_Last: return "UNKNOWN_ENTITY_KIND";
+    }
+    return nullptr;
+}
+
+const char* PF::toString(const PF::PoolOverflowPolicy poolOverflowPolicy)
+{
+    switch (poolOverflowPolicy)
+    {
+        case PF::PoolOverflowPolicy::DROP_NEWEST: return "DROP_NEWEST";
+        case PF::PoolOverflowPolicy::RECYCLE_OLDEST: return "RECYCLE_OLDEST";
+        case PF::PoolOverflowPolicy::PoolOverflowPolicy_Last: return "UNKNOWN_POOL_OVERFLOW_POLICY";
+    }
+    return nullptr;
+}
+
+const char* PF::toString(const PF::SimdLevel simdLevel)
+{
+    switch (simdLevel)
+    {
+        case PF::SimdLevel::SCALAR: return "SCALAR";
+        case PF::SimdLevel::SSE2: return "SSE2";
+        case PF::SimdLevel::AVX2: return "AVX2";
+        case PF::SimdLevel::NEON: return "NEON";
+        case PF::SimdLevel::SimdLevel_Last: return "UNKNOWN_SIMD_LEVEL";
+    }
+    return nullptr;
+}
+
+const char* PF::toString(const PF::LogLevel logLevel)
+{
+    switch (logLevel)
+    {
+        case PF::LogLevel::VERBOSE: return "VERBOSE";
+        case PF::LogLevel::INFO: return "INFO";
+        case PF::LogLevel::WARNING: return "WARNING";
+        case PF::LogLevel::CRITICAL: return "CRITICAL";
+        case PF::LogLevel::LogLevel_Last: return "UNKNOWN_LOG_LEVEL";
+    }
+    return nullptr;
+}
@@ -18,6 +18,50 @@ enum class PlayerIntention
     PlayerIntention_Last
 };
 
+enum class EntityKind
+{
+    PLAYER,
+    PARTICLE,  // Held by an emitter of the ParticleSystem rather than by a store of EntityKinds
+    EntityKind_Last
+};
+
+enum class PoolOverflowPolicy
+{
+    DROP_NEWEST,     // Refuse the new element while the pool is full
+    RECYCLE_OLDEST,  // Retire the oldest live element to make room for the new one
+    PoolOverflowPolicy_Last
+};
+
+enum class SimdLevel
+{
+    SCALAR,  // Portable fallback, one element at a time
+    SSE2,    // 4 float lanes on x86
+    AVX2,    // 8 float lanes on x86
+    NEON,    // 4 float lanes on ARM
+    SimdLevel_Last
+};
+
+enum class LogLevel
+{
+    VERBOSE,   // Chatty diagnostics, e.g. every player intention
+    INFO,      // Notable events, e.g. an asset loaded
+    WARNING,   // Something went wrong, the game carries on
+    CRITICAL,  // Something went wrong, the game cannot carry on
+    LogLevel_Last
+};
+
 [[nodiscard]]
 const char* toString(PlayerIntention playerIntention);
+
+[[nodiscard]]
+const char* toString(EntityKind entityKind);
+
+[[nodiscard]]
+const char* toString(PoolOverflowPolicy poolOverflowPolicy);
+
+[[nodiscard]]
+const char* toString(SimdLevel simdLevel);
+
+[[nodiscard]]
+const char* toString(LogLevel logLevel);
 }  // namespace PF
@@ -0,0 +1,44 @@
+#include <cassert>
+#include <cstddef>
+
+#include "FixedTimestep.h"
+
+PF::FixedTimestep::FixedTimestep(Uint64 stepNs, std::size_t maxStepsPerFrame)
+    : m_stepNs(stepNs), m_maxStepsPerFrame(maxStepsPerFrame)
+{
+    assert(stepNs > 0 && "Simulation step must be longer than zero.");
+    assert(maxStepsPerFrame > 0 && "At least one step per frame must be allowed.");
+}
+
+void PF::FixedTimestep::reset(Uint64 nowNs)
+{
+    m_lastNs = nowNs;
+    m_accumulatorNs = 0;
+}
+
+std::size_t PF::FixedTimestep::advance(Uint64 nowNs)
+{
+    // A clock going backwards counts as no time elapsed rather than wrapping around
+    if (nowNs > m_lastNs) { m_accumulatorNs += nowNs - m_lastNs; }
+    m_lastNs = nowNs;
+
+    Uint64 steps = m_accumulatorNs / m_stepNs;
+    m_accumulatorNs -= steps * m_stepNs;
+    if (steps > m_maxStepsPerFrame)
+    {
+        m_droppedStepCount += steps - m_maxStepsPerFrame;
+        steps = m_maxStepsPerFrame;
+    }
+    return static_cast<std::size_t>(steps);
+}
+
+float PF::FixedTimestep::getAlpha() const
+{
+    return static_cast<float>(m_accumulatorNs) / static_cast<float>(m_stepNs);
+}
+
+Uint64 PF::FixedTimestep::getStateTimeNs() const { return m_lastNs - m_accumulatorNs; }
+
+Uint64 PF::FixedTimestep::getStepNs() const { return m_stepNs; }
+
+Uint64 PF::FixedTimestep::getDroppedStepCount() const { return m_droppedStepCount; }
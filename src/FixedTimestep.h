@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+
+namespace PF
+{
+/**
+ * @class FixedTimestep
+ * @brief Turns wall-clock frames into a whole number of constant simulation steps.
+ *
+ * Elapsed time is accumulated every frame and spent in steps of exactly `stepNs`, so the simulation behaves the same
+ * whatever the display refresh rate. What is left over is less than one step: it becomes the interpolation alpha the
+ * frame is rendered with.
+ *
+ * After a long hitch, at most `maxStepsPerFrame` steps are run and the rest of the backlog is dropped: the game slows
+ * down for a moment instead of spending ever longer frames catching up.
+ */
+class FixedTimestep
+{
+  public:
+    /**
+     * @param stepNs The duration of a simulation step, in nanoseconds.
+     * @param maxStepsPerFrame The largest number of steps a single frame may run.
+     */
+    FixedTimestep(Uint64 stepNs, std::size_t maxStepsPerFrame);
+
+    /**
+     * @brief Starts measuring time from `nowNs`, with an empty accumulator.
+     */
+    void reset(Uint64 nowNs);
+
+    /**
+     * @brief Accumulates the time elapsed since the previous call.
+     * @param nowNs The current time, e.g. from SDL_GetTicksNS().
+     * @return The number of steps to run this frame.
+     */
+    std::size_t advance(Uint64 nowNs);
+
+    /**
+     * @brief Gets how far the simulation is into the next step, from 0 to 1. Render with it to interpolate positions.
+     */
+    [[nodiscard]] float getAlpha() const;
+
+    /**
+     * @brief Gets the time the simulation state is current at: the last advance() minus the time not spent in steps.
+     * A renderer running apart from the simulation interpolates from there.
+     */
+    [[nodiscard]] Uint64 getStateTimeNs() const;
+
+    [[nodiscard]] Uint64 getStepNs() const;
+
+    /**
+     * @brief Gets the number of steps skipped so far because frames fell too far behind.
+     */
+    [[nodiscard]] Uint64 getDroppedStepCount() const;
+
+  private:
+    Uint64 m_stepNs;
+    std::size_t m_maxStepsPerFrame;
+    Uint64 m_lastNs = 0;         // Time of the previous advance() or reset()
+    Uint64 m_accumulatorNs = 0;  // Elapsed time not spent in steps yet, always less than one step after advance()
+    Uint64 m_droppedStepCount = 0;
+};
+}  // namespace PF
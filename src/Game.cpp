@@ -1,16 +1,43 @@
-#include <iterator>
-#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "Attack.h"
 #include "Enums.h"
 #include "Game.h"
-#include "Object.h"
-#include "Player.h"
+#include "GlobalDefinitions.h"
+#include "Log.h"
+#include "Profiler.h"
 
-PF::Game::Game(SDL_Renderer* renderer): m_renderer(renderer), m_textureManager(renderer)
+constexpr const char* ASSET_PACK_PATH = "../../assets/assets.pfpack";  // Optional, built by perfectform_packer
+constexpr Uint64 TEXTURE_UPLOAD_BUDGET_NS = 2'000'000;  // Share of a frame spent copying loaded images to the atlas
+constexpr double BYTES_PER_MEBIBYTE = 1024.0 * 1024.0;
+
+PF::Game::Game(SDL_Renderer* renderer, std::size_t threadCount, Uint64 seed)
+    : m_renderer(renderer), m_seed(seed), m_jobSystem(threadCount), m_textureManager(renderer),
+      m_camera({static_cast<float>(PF::Global::Window::GetWindowDimensions().x),
+                static_cast<float>(PF::Global::Window::GetWindowDimensions().y)},
+               {0.0F, 0.0F})
 {
+    // Projectiles far enough off-screen will never be seen again
+    m_camera.setRetireMargin(PF::Global::Model::RETIRE_MARGIN);
+
+    // Prefer pre-decoded pixels when the pack was built, individual images otherwise
+    if (!m_textureManager.isHeadless() && std::filesystem::exists(ASSET_PACK_PATH))
+    {
+        m_textureManager.mountPack(ASSET_PACK_PATH);
+    }
+
     // Initialize game objects
     initializePlayer();
+
+    // Something to draw before the first update
+    if (!m_textureManager.isHeadless()) { publishSnapshot(0); }
 }
 
 void PF::Game::initializePlayer()
@@ -20,104 +47,210 @@ void PF::Game::initializePlayer()
     const float playerSrcHeight = 64.0F;
     SDL_FRect srcRect = {0, 0, playerSrcWidth, playerSrcHeight};
 
-    // Starting position
-    const float playerStartX = 1280 / 2.0F;
-    const float playerStartY = 720 / 2.0F;
-    SDL_FPoint position = {playerStartX, playerStartY};
+    // Starting position, in world coordinates: the camera starts centred on it
+    SDL_FPoint position = m_camera.getPosition();
 
     // Starting size
     float startSize = 1.0F;
 
-    // Load texture
-    const auto textureIdx = m_textureManager.addTexture("../../assets/BaseCell_64x64.png");
+    // Load texture in the background, the player shows the placeholder until it is uploaded. Attacks share it and
+    // shrink to a few pixels, so it comes with its 32x32 version and mipmaps below that
+    m_playerTexture = m_textureManager.addTextureAsync(
+        "../../assets/BaseCell_64x64.png",
+        {.levelPaths = {"../../assets/BaseCell_32x32.png"}, .generateMipmaps = true});
 
-    // Create player object
-    m_player = std::make_shared<PF::Player>(textureIdx, srcRect, position, startSize);
-    m_objects.emplace_back(m_player);
+    // Create player entity, firing its attacks through an emitter drawn with its own texture
+    // Attack seeds derive from the player's, so the whole session follows from the game seed
+    const std::size_t player =
+        m_entities.getPlayers().add(m_playerTexture.get(), srcRect, position, startSize, m_seed);
+    const std::size_t attacks =
+        m_entities.getParticles().addEmitter(PF::Attack::makeEmitterConfig(m_playerTexture.get(), srcRect));
+    m_entities.getParticles().attach({.kind = PF::PlayerStore::KIND, .index = static_cast<std::uint32_t>(player)},
+                                     attacks);
+    m_input.subscribe(m_entities.getPlayers(), PF::InputRouter::allIntentions());
+
+    // Sized for a full attack pool, so the broad phase never allocates mid-game
+    const std::size_t maxEntities =
+        m_entities.getPlayers().count() + m_entities.getParticles().getEmitter(attacks).getCapacity();
+    m_spatialHash.reserve(maxEntities);
 }
 
 void PF::Game::update(Uint64 stepMs)
 {
-    // Update all game objects
-    for (auto& object : m_objects) { object->update(stepMs); }
+    const PF::AllocationTracker::AllocationCounts allocationsBefore = PF::AllocationTracker::getThreadCounts();
+    {
+        const std::scoped_lock lock(m_inputMutex);
+        if (m_replay)
+        {
+            const auto& events = m_replay->getEvents();
+            for (; m_replayCursor < events.size() && events[m_replayCursor].tick <= m_tick; ++m_replayCursor)
+            {
+                m_input.push(events[m_replayCursor].intention);
+            }
+        }
+        const auto intentions = m_input.dispatch();
+        if (m_recording)
+        {
+            for (const auto intention : intentions) { m_recording->record(m_tick, intention); }
+        }
+    }
 
-    // Remove objects that should be removed after updating
-    std::erase_if(m_objects, [](const auto& object) { return object->shouldRemove(); });
+    {
+        PF_PROFILE_ZONE("EntityStore::update");
+        m_entities.update(stepMs, m_jobSystem);
+    }
 
-    // Spawn new objects based on the current objects
-    std::vector<std::shared_ptr<PF::Object>> newObjects;
-    for (auto& object : m_objects)
+    if (const auto retireMargin = m_camera.getRetireMargin())
     {
-        auto newObject = object->spawnChildObject();
-        if (newObject) { newObjects.emplace_back(newObject); }
+        m_entities.getParticles().removeOutside(m_camera.getVisibleArea(*retireMargin));
     }
-    m_objects.insert(
-        m_objects.end(), std::make_move_iterator(newObjects.begin()), std::make_move_iterator(newObjects.end()));
+
+    PF_PROFILE_ZONE("SpatialHash::rebuild");
+    m_spatialHash.rebuild(m_entities);
+    ++m_tick;
+    m_tickAllocations = PF::AllocationTracker::getThreadCounts() - allocationsBefore;
 }
 
 void PF::Game::handleEvent(SDL_Event* event)
 {
-    const auto playerIntention = getPlayerIntention(event);
+    if (m_replay) { return; }  // The recording drives the player
+    const std::scoped_lock lock(m_inputMutex);
+    m_input.handleEvent(*event);
+}
+
+void PF::Game::handleIntention(PF::PlayerIntention playerIntention)
+{
+    if (m_replay) { return; }  // The recording drives the player
+    const std::scoped_lock lock(m_inputMutex);
+    m_input.push(playerIntention);
+}
+
+void PF::Game::startRecording()
+{
+    assert(!m_replay && "Cannot record while replaying.");
+    m_recording.emplace(m_seed, m_entities.getParticles().getSimdLevel());
+}
+
+std::optional<PF::InputRecording> PF::Game::stopRecording()
+{
+    if (m_recording) { m_recording->setTickCount(m_tick); }
+    return std::exchange(m_recording, std::nullopt);
+}
+
+void PF::Game::startReplay(PF::InputRecording recording)
+{
+    assert(!m_recording && "Cannot replay while recording.");
+    if (recording.getSeed() != m_seed) { PF_LOG_WARNING("Replaying with a different seed, the session will diverge."); }
 
-    for (auto& object : m_objects) { object->handleEvent(playerIntention); }
+    // The kernel widths round differently, so use the recorded one whenever this CPU runs it
+    const PF::SimdLevel recorded = recording.getSimdLevel();
+    const PF::SimdLevel detected = m_entities.getParticles().getSimdLevel();
+    const bool supported = recorded == detected || recorded == PF::SimdLevel::SCALAR ||
+                           (recorded == PF::SimdLevel::SSE2 && detected == PF::SimdLevel::AVX2);
+    if (supported) { m_entities.getParticles().setSimdLevel(recorded); }
+    else
+    {
+        PF_LOG_WARNING("Replay recorded with %s, running %s: positions may drift slightly.",
+                       PF::toString(recorded),
+                       PF::toString(detected));
+    }
+
+    m_replay = std::move(recording);
+    m_replayCursor = 0;
 }
 
-void PF::Game::render() const
+bool PF::Game::isReplayFinished() const { return m_replay && m_tick >= m_replay->getTickCount(); }
+
+Uint64 PF::Game::getTick() const { return m_tick; }
+
+void PF::Game::uploadTextures()
 {
-    for (const auto& object : m_objects) { object->render(m_renderer, m_textureManager); }
+    PF_PROFILE_ZONE("Game::uploadTextures");
+    m_textureManager.uploadLoaded(TEXTURE_UPLOAD_BUDGET_NS);
 }
 
-namespace
+bool PF::Game::isLoaded() const { return m_textureManager.getPendingCount() == 0; }
+
+void PF::Game::publishSnapshot(Uint64 stateTimeNs)
 {
-void LogIntentionFromEvent(SDL_Event* event, const PF::PlayerIntention playerIntention)
+    PF_PROFILE_ZONE("Game::publishSnapshot");
+    PF::RenderSnapshot& snapshot = m_snapshots.getWriteBuffer();
+    snapshot.sprites.clear();  // Keeps its capacity, the buffers are reused
+    snapshot.particles.clear();
+    snapshot.particleBatches.clear();
+    snapshot.camera = m_camera;
+    m_entities.capture(snapshot, m_camera);
+    snapshot.tick = m_tick;
+    snapshot.tickAllocations = m_tickAllocations;
+    snapshot.stateTimeNs = stateTimeNs;
+    snapshot.replayFinished = isReplayFinished();
+    m_snapshots.publish();
+}
+
+const PF::RenderSnapshot& PF::Game::acquireSnapshot()
 {
-    // Log the player intention and the event type
-    SDL_Log("Player intention: %s - from SDL_Event: %s | 0x%x",
-            PF::toString(playerIntention),
-            SDL_GetKeyName(event->key.key),
-            event->type);
+    m_snapshots.acquire();
+    return m_snapshots.getReadBuffer();
 }
-}  // namespace
 
-PF::PlayerIntention PF::Game::getPlayerIntention(SDL_Event* event)
+void PF::Game::render(float alpha) const
 {
-    PF::PlayerIntention playerIntention = PF::PlayerIntention::NONE;
-    switch (event->type)
+    assert(m_renderer && "render() called on a headless game.");
+
+    m_spriteBatch.begin();
     {
-        case SDL_EVENT_KEY_DOWN:
-        {
-            switch (event->key.key)
-            {
-                case SDLK_UP: playerIntention = PF::PlayerIntention::MOVE_UP; break;
-                case SDLK_DOWN: playerIntention = PF::PlayerIntention::MOVE_DOWN; break;
-                case SDLK_LEFT: playerIntention = PF::PlayerIntention::MOVE_LEFT; break;
-                case SDLK_RIGHT: playerIntention = PF::PlayerIntention::MOVE_RIGHT; break;
-                case SDLK_Q: playerIntention = PF::PlayerIntention::ATTACK; break;
-                default: break;
-            }
-            LogIntentionFromEvent(event, playerIntention);
-            break;
-        }
-        case SDL_EVENT_KEY_UP:
-        {
-            switch (event->key.key)
-            {
-                case SDLK_UP: playerIntention = PF::PlayerIntention::MOVE_STOP_UP; break;
-                case SDLK_DOWN: playerIntention = PF::PlayerIntention::MOVE_STOP_DOWN; break;
-                case SDLK_LEFT: playerIntention = PF::PlayerIntention::MOVE_STOP_LEFT; break;
-                case SDLK_RIGHT: playerIntention = PF::PlayerIntention::MOVE_STOP_RIGHT; break;
-                case SDLK_Q: playerIntention = PF::PlayerIntention::ATTACK_STOP; break;
-                default: break;
-            }
-            LogIntentionFromEvent(event, playerIntention);
-            break;
-        }
-        default: break;
+        PF_PROFILE_ZONE("RenderSnapshot::draw");
+        m_snapshots.getReadBuffer().draw(m_spriteBatch, m_textureManager, alpha);
     }
+    PF_PROFILE_ZONE("SpriteBatch::flush");
+    m_spriteBatch.flush(m_renderer);
+}
+
+void PF::Game::renderProfilerOverlay() const
+{
+    assert(m_renderer && "renderProfilerOverlay() called on a headless game.");
 
-    return playerIntention;
+    const PF::RenderSnapshot& snapshot = m_snapshots.getReadBuffer();
+    const PF::TextureCacheStats cacheStats = m_textureManager.getCacheStats();
+    std::vector<std::string> lines = {
+        std::format("players {} particles {} (pool high-water mark {})",
+                    snapshot.entityCounts[static_cast<std::size_t>(PF::EntityKind::PLAYER)],
+                    snapshot.particleCount,
+                    snapshot.particleHighWaterMark),
+        std::format("draw calls {} quads {}", m_spriteBatch.getDrawCallCount(), m_spriteBatch.getQuadCount()),
+        std::format("atlas pages {} pending loads {}",
+                    m_textureManager.getPageCount(),
+                    m_textureManager.getPendingCount()),
+        std::format("texture cache hits {} misses {} evictions {} resident {:.1f} MiB",
+                    cacheStats.hits,
+                    cacheStats.misses,
+                    cacheStats.evictions,
+                    static_cast<double>(cacheStats.residentBytes) / BYTES_PER_MEBIBYTE)};
+    if constexpr (PF::AllocationTracker::ENABLED)
+    {
+        lines.push_back(std::format("allocations last tick {} ({} B)",
+                                    snapshot.tickAllocations.allocations,
+                                    snapshot.tickAllocations.bytes));
+    }
+    PF::Profiler::drawOverlay(m_renderer, lines);
 }
 
+PF::Camera& PF::Game::getCamera() { return m_camera; }
+
+const PF::Camera& PF::Game::getCamera() const { return m_camera; }
+
+PF::InputRouter& PF::Game::getInput() { return m_input; }
+
+const PF::InputRouter& PF::Game::getInput() const { return m_input; }
+
 PF::TextureManager& PF::Game::getTextureManager() { return m_textureManager; }
 
 const PF::TextureManager& PF::Game::getTextureManager() const { return m_textureManager; }
+
+std::size_t PF::Game::getThreadCount() const { return m_jobSystem.getThreadCount(); }
+
+const PF::SpatialHash& PF::Game::getSpatialHash() const { return m_spatialHash; }
+
+PF::EntityStore& PF::Game::getEntities() { return m_entities; }
+
+const PF::EntityStore& PF::Game::getEntities() const { return m_entities; }
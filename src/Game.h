@@ -2,43 +2,179 @@
 
 #include <SDL3/SDL.h>
 
-#include <memory>
-#include <vector>
+#include <cstddef>
+#include <mutex>
+#include <optional>
 
+#include "AllocationTracker.h"
+#include "Camera.h"
+#include "EntityStore.h"
 #include "Enums.h"
+#include "InputRecording.h"
+#include "InputRouter.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include "Scene.h"
+#include "SpatialHash.h"
+#include "SpriteBatch.h"
 #include "TextureManager.h"
+#include "TripleBuffer.h"
 
 namespace PF
 {
-class Object;
-class Player;
-
 /**
  * @brief Main game class responsible for managing game state and resources
+ *
+ * Building a game touches no renderer state, so the scene manager can preload one on a background thread.
+ *
+ * The simulation and the drawing can run on different threads, e.g. with a SimulationThread: update() and
+ * publishSnapshot() on the simulation thread, uploadTextures(), acquireSnapshot() and render() on the render thread.
+ * They only meet in a triple buffer of render snapshots. Input may be handled from either thread.
  */
-class Game
+class Game : public PF::Scene
 {
   public:
-    explicit Game(SDL_Renderer* renderer);
+    static constexpr Uint64 DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+    /**
+     * @brief Constructs the game and its initial entities.
+     * @param renderer The renderer to draw with, or nullptr to run headless: textures are then registered but never
+     * uploaded, and render() must not be called.
+     * @param threadCount The number of threads updating the entities, including the calling one. Zero picks one per
+     * hardware thread.
+     * @param seed The seed every entity's random generator derives from. Two games with the same seed, fed the same
+     * intentions at the same ticks, evolve identically.
+     */
+    explicit Game(SDL_Renderer* renderer, std::size_t threadCount = 0, Uint64 seed = DEFAULT_SEED);
+
+    /**
+     * @brief Advances the game by one tick. First delivers the intentions queued since the previous tick, or while
+     * replaying the ones recorded for this tick.
+     */
+    void update(Uint64 stepMs) override;
+
+    /**
+     * @brief Updates the keyboard state, and queues the intention the event is bound to for the next update().
+     * Ignored while replaying. Safe to call while another thread runs update().
+     */
+    void handleEvent(SDL_Event* event) override;
+
+    /**
+     * @brief Queues an already decoded intention, e.g. from a script instead of the keyboard. It applies before the
+     * next update() and is recorded with that tick. Ignored while replaying. Safe to call while another thread runs
+     * update().
+     */
+    void handleIntention(PF::PlayerIntention playerIntention);
+
+    /**
+     * @brief Starts recording every intention handled from now on, with the seed needed to replay them.
+     */
+    void startRecording();
+
+    /**
+     * @brief Stops recording.
+     * @return The intentions handled since startRecording(), lasting until the current tick, or std::nullopt if the
+     * game was not recording.
+     */
+    [[nodiscard]] std::optional<PF::InputRecording> stopRecording();
+
+    /**
+     * @brief Feeds a recording back tick by tick, replacing live input. The game must be fresh, built with the
+     * recording's seed, for the replay to reproduce the session.
+     */
+    void startReplay(PF::InputRecording recording);
+
+    /**
+     * @brief Checks whether a replay is running and has reached the recording's last tick.
+     */
+    [[nodiscard]] bool isReplayFinished() const;
+
+    /**
+     * @brief Gets the number of update() calls since construction.
+     */
+    [[nodiscard]] Uint64 getTick() const;
 
-    void update(Uint64 stepMs);
+    /**
+     * @brief Copies the images loaded in the background into the atlas, within a small per-frame time budget. Call
+     * once per frame on the render thread, before render().
+     */
+    void uploadTextures() override;
 
-    void handleEvent(SDL_Event* event);
+    /**
+     * @brief Copies what the current state looks like into a render snapshot, and hands it to the render thread.
+     * @param stateTimeNs The wall-clock time the state is current at, to interpolate from.
+     */
+    void publishSnapshot(Uint64 stateTimeNs);
 
-    void render() const;
+    /**
+     * @brief Takes the latest published snapshot as the one render() draws, until the next call. Call once per frame
+     * on the render thread.
+     */
+    const PF::RenderSnapshot& acquireSnapshot();
+
+    /**
+     * @brief Draws the acquired snapshot, its entities between their previous and current positions.
+     * @param alpha How far into the snapshot's step to draw, from 0 (previous positions) to 1 (current positions).
+     */
+    void render(float alpha) const override;
+
+    /**
+     * @brief Checks whether every image the game registered is in the atlas.
+     */
+    [[nodiscard]] bool isLoaded() const override;
+
+    /**
+     * @brief Draws the profiler overlay, with the entity counts of the acquired snapshot and the draw call counts of
+     * the last frame.
+     */
+    void renderProfilerOverlay() const;
+
+    PF::Camera& getCamera();
+    const PF::Camera& getCamera() const;
+
+    /**
+     * @brief Gets the input router. Not synchronized: only use while no other thread runs update().
+     */
+    PF::InputRouter& getInput();
+    const PF::InputRouter& getInput() const;
 
     PF::TextureManager& getTextureManager();
     const PF::TextureManager& getTextureManager() const;
 
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+    /**
+     * @brief Gets the broad phase of the current tick, rebuilt at the end of every update().
+     */
+    [[nodiscard]] const PF::SpatialHash& getSpatialHash() const;
+
+    [[nodiscard]] PF::EntityStore& getEntities();
+    [[nodiscard]] const PF::EntityStore& getEntities() const;
+
   private:
     void initializePlayer();  // Initialize player object
 
-    static PF::PlayerIntention getPlayerIntention(SDL_Event* event);  // Get player intention from event
-
   private:
-    SDL_Renderer* m_renderer = nullptr;              // Pointer to the SDL renderer
-    PF::TextureManager m_textureManager;             // Texture manager for handling textures
-    std::vector<std::shared_ptr<Object>> m_objects;  // Collection of game objects
-    std::shared_ptr<Player> m_player;                // Pointer to the player object.
+    SDL_Renderer* m_renderer = nullptr;                // Pointer to the SDL renderer
+    Uint64 m_seed;                                     // Root of every entity's random generator
+    Uint64 m_tick = 0;                                 // Number of updates so far
+    PF::JobSystem m_jobSystem;                         // Worker threads running the parallel entity passes
+    PF::TextureManager m_textureManager;               // Texture manager for handling textures
+    PF::TextureHandle m_playerTexture;                 // Keeps the players' image loaded, released before the manager
+    PF::Camera m_camera;                               // Maps world coordinates to the window
+    PF::EntityStore m_entities;                        // Column storage for every game entity
+    PF::SpatialHash m_spatialHash;                     // Proximity index over m_entities, refreshed every tick
+    PF::InputRouter m_input;                           // Keyboard state, and intentions queued for the next tick
+    std::mutex m_inputMutex;                           // Guards m_input, fed by the render thread or the replay
+    PF::TripleBuffer<PF::RenderSnapshot> m_snapshots;  // From the simulation thread to the render thread
+    mutable PF::SpriteBatch m_spriteBatch;             // Per-frame sprite batch, reused to avoid reallocations
+    std::optional<PF::InputRecording> m_recording;     // Intentions handled so far, while recording
+    std::optional<PF::InputRecording> m_replay;        // Intentions to feed back, while replaying
+    std::size_t m_replayCursor = 0;                    // Next event of m_replay to apply
+
+    // Made during the last update() by the thread running it, so the render thread's are left out. So are the job
+    // system workers', which only reuse their buffers once warmed up: the headless run counts the whole process
+    // instead. Always zero unless allocation tracking is compiled in, see AllocationTracker.h.
+    PF::AllocationTracker::AllocationCounts m_tickAllocations{};
 };
 }  // namespace PF
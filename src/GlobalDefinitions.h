@@ -2,6 +2,8 @@
 
 #include <SDL3/SDL.h>
 
+#include <cstddef>
+
 namespace PF::Global
 {
 namespace Window
@@ -16,6 +18,10 @@ inline void SetDimensions(SDL_Point dimensions) { g_dimensions = dimensions; }
 namespace Model
 {
 constexpr int SIMULATION_STEP_RATE_MS = 10;
+constexpr std::size_t MAX_CATCH_UP_STEPS = 5;     // Steps a frame may run at most, the rest of a backlog is dropped
+constexpr std::size_t MAX_ATTACK_COUNT = 8192;    // Capacity of the attack projectile pool
+constexpr float MIN_VELOCITY_THRESHOLD = 0.001F;  // Speeds at or below this count as standing still
+constexpr float RETIRE_MARGIN = 512.0F;           // Distance beyond the view, in world units, of retired projectiles
 }  // namespace Model
 
 namespace Colors
@@ -0,0 +1,180 @@
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "EntityColumns.h"
+#include "Enums.h"
+#include "Game.h"
+#include "GlobalDefinitions.h"
+#include "HeadlessSimulation.h"
+#include "InputRecording.h"
+#include "Log.h"
+#include "ParticleSystem.h"
+
+constexpr std::size_t SCRIPT_TURN_TICKS = 150;  // Ticks spent walking in each direction
+constexpr double MICROSECONDS_PER_SECOND = 1e6;
+constexpr Uint64 FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr Uint64 FNV_PRIME = 0x100000001B3ULL;
+
+namespace
+{
+// Walk in a square so attacks are fired in every direction, releasing the previous key before pressing the next one
+constexpr std::array<std::array<PF::PlayerIntention, 2>, 4> SCRIPT_TURNS = {
+    {{PF::PlayerIntention::MOVE_STOP_LEFT, PF::PlayerIntention::MOVE_UP},
+     {PF::PlayerIntention::MOVE_STOP_UP, PF::PlayerIntention::MOVE_RIGHT},
+     {PF::PlayerIntention::MOVE_STOP_RIGHT, PF::PlayerIntention::MOVE_DOWN},
+     {PF::PlayerIntention::MOVE_STOP_DOWN, PF::PlayerIntention::MOVE_LEFT}}
+};
+
+void DriveScript(PF::Game& game, const std::size_t tick)
+{
+    if (tick == 0) { game.handleIntention(PF::PlayerIntention::ATTACK); }
+    if (tick % SCRIPT_TURN_TICKS != 0) { return; }
+
+    const auto& turn = SCRIPT_TURNS.at((tick / SCRIPT_TURN_TICKS) % SCRIPT_TURNS.size());
+    for (const auto intention : turn) { game.handleIntention(intention); }
+}
+
+// FNV-1a over the exact bits, so any divergence shows up
+void HashFloat(Uint64& hash, float value)
+{
+    hash ^= std::bit_cast<std::uint32_t>(value);
+    hash *= FNV_PRIME;
+}
+
+void HashColumns(Uint64& hash, const PF::EntityColumns& columns)
+{
+    for (std::size_t i = 0; i < columns.count(); ++i)
+    {
+        HashFloat(hash, columns.positionX[i]);
+        HashFloat(hash, columns.positionY[i]);
+        HashFloat(hash, columns.size[i]);
+    }
+}
+
+void HashParticles(Uint64& hash, const PF::ParticleSystem& particles)
+{
+    // Oldest first, whatever slot the ring buffer put them in
+    for (std::size_t i = 0; i < particles.getEmitterCount(); ++i)
+    {
+        const PF::ParticleEmitter& emitter = particles.getEmitter(i);
+        const PF::ParticleColumns& columns = emitter.getColumns();
+        for (std::size_t age = 0; age < emitter.count(); ++age)
+        {
+            const std::size_t slot = emitter.getSlot(age);
+            HashFloat(hash, columns.positionX[slot]);
+            HashFloat(hash, columns.positionY[slot]);
+            HashFloat(hash, columns.size[slot]);
+        }
+    }
+}
+
+double Percentile(const std::vector<Uint64>& sortedTicks, const double percentile, const double toMicroseconds)
+{
+    if (sortedTicks.empty()) { return 0.0; }
+    const auto rank = static_cast<std::size_t>(std::ceil(percentile * static_cast<double>(sortedTicks.size())));
+    const std::size_t index = std::clamp<std::size_t>(rank, 1, sortedTicks.size()) - 1;
+    return static_cast<double>(sortedTicks[index]) * toMicroseconds;
+}
+}  // namespace
+
+PF::Headless::Report PF::Headless::runSimulation(std::size_t ticks,
+                                                 std::size_t threadCount,
+                                                 const PF::InputRecording* replay)
+{
+    PF::Game game(nullptr, threadCount, replay != nullptr ? replay->getSeed() : PF::Game::DEFAULT_SEED);
+    if (replay != nullptr)
+    {
+        game.startReplay(*replay);
+        if (ticks == 0) { ticks = static_cast<std::size_t>(replay->getTickCount()); }
+    }
+
+    std::vector<Uint64> tickDurations;
+    tickDurations.reserve(ticks);
+
+    Report report;
+    report.ticks = ticks;
+    report.threads = game.getThreadCount();
+    for (std::size_t tick = 0; tick < ticks; ++tick)
+    {
+        if (replay == nullptr) { DriveScript(game, tick); }
+
+        const PF::AllocationTracker::AllocationCounts allocationsBefore = PF::AllocationTracker::getProcessCounts();
+        const Uint64 start = SDL_GetPerformanceCounter();
+        game.update(PF::Global::Model::SIMULATION_STEP_RATE_MS);
+        tickDurations.push_back(SDL_GetPerformanceCounter() - start);
+        const PF::AllocationTracker::AllocationCounts allocations =
+            PF::AllocationTracker::getProcessCounts() - allocationsBefore;
+
+        report.peakEntityCount = std::max(report.peakEntityCount, game.getEntities().count());
+
+        // Nothing else runs meanwhile, so the whole process's allocations, the job system workers' too, are the tick's
+        if (tick >= ALLOCATION_WARMUP_TICKS && allocations.allocations > 0)
+        {
+            if (report.allocatingTicks == 0)
+            {
+                PF_LOG_WARNING("Tick %zu allocated %llu times (%llu bytes) after the warm-up.",
+                               tick,
+                               allocations.allocations,
+                               allocations.bytes);
+            }
+            ++report.allocatingTicks;
+            report.steadyStateAllocations += allocations.allocations;
+            report.steadyStateBytes += allocations.bytes;
+        }
+    }
+
+    report.finalEntityCount = game.getEntities().count();
+    report.stateChecksum = FNV_OFFSET_BASIS;
+    game.getEntities().forEachKind([&](const auto& store) { HashColumns(report.stateChecksum, store.getColumns()); });
+    HashParticles(report.stateChecksum, game.getEntities().getParticles());
+
+    const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const double toMicroseconds = MICROSECONDS_PER_SECOND / frequency;
+
+    Uint64 totalCounter = 0;
+    for (const auto duration : tickDurations) { totalCounter += duration; }
+    report.totalSeconds = static_cast<double>(totalCounter) / frequency;
+    report.ticksPerSecond = report.totalSeconds > 0.0 ? static_cast<double>(ticks) / report.totalSeconds : 0.0;
+
+    std::ranges::sort(tickDurations);
+    report.p50Us = Percentile(tickDurations, 0.50, toMicroseconds);
+    report.p90Us = Percentile(tickDurations, 0.90, toMicroseconds);
+    report.p99Us = Percentile(tickDurations, 0.99, toMicroseconds);
+    report.maxUs = tickDurations.empty() ? 0.0 : static_cast<double>(tickDurations.back()) * toMicroseconds;
+    return report;
+}
+
+void PF::Headless::logReport(const Report& report)
+{
+    PF_LOG_INFO("Headless simulation: %zu ticks of %d ms on %zu threads in %.3f s (%.1f ticks/s), peak %zu entities",
+                report.ticks,
+                PF::Global::Model::SIMULATION_STEP_RATE_MS,
+                report.threads,
+                report.totalSeconds,
+                report.ticksPerSecond,
+                report.peakEntityCount);
+    PF_LOG_INFO("Tick latency (us): p50 %.2f | p90 %.2f | p99 %.2f | max %.2f",
+                report.p50Us,
+                report.p90Us,
+                report.p99Us,
+                report.maxUs);
+    PF_LOG_INFO("Final state: %zu entities, checksum %016llx",
+                report.finalEntityCount,
+                report.stateChecksum);
+    if constexpr (PF::AllocationTracker::ENABLED)
+    {
+        PF_LOG_INFO("Allocations after %zu warm-up ticks: %zu ticks allocated, %llu allocations, %llu bytes",
+                    ALLOCATION_WARMUP_TICKS,
+                    report.allocatingTicks,
+                    report.steadyStateAllocations,
+                    report.steadyStateBytes);
+    }
+}
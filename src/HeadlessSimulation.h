@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+
+namespace PF
+{
+class InputRecording;
+}
+
+namespace PF::Headless
+{
+constexpr std::size_t ALLOCATION_WARMUP_TICKS = 60;  // Ticks for every pool and scratch buffer to reach its size
+
+/**
+ * @struct Report
+ * @brief Throughput and latency figures of a headless simulation run.
+ */
+struct Report
+{
+    std::size_t ticks = 0;             /**< Number of simulated ticks. */
+    std::size_t threads = 0;           /**< Number of threads updating the entities. */
+    double totalSeconds = 0.0;         /**< Wall time spent inside Game::update. */
+    double ticksPerSecond = 0.0;       /**< Simulation throughput. */
+    double p50Us = 0.0;                /**< Median tick latency, in microseconds. */
+    double p90Us = 0.0;                /**< 90th percentile tick latency, in microseconds. */
+    double p99Us = 0.0;                /**< 99th percentile tick latency, in microseconds. */
+    double maxUs = 0.0;                /**< Slowest tick, in microseconds. */
+    std::size_t peakEntityCount = 0;   /**< Highest number of live entities seen after a tick. */
+    std::size_t finalEntityCount = 0;  /**< Number of live entities after the last tick. */
+    Uint64 stateChecksum = 0;          /**< Hash of every entity's position and size after the last tick. */
+    std::size_t allocatingTicks = 0;   /**< Ticks past ALLOCATION_WARMUP_TICKS that allocated. */
+    Uint64 steadyStateAllocations = 0; /**< Allocations made by those ticks. */
+    Uint64 steadyStateBytes = 0;       /**< Bytes requested by those allocations. */
+};
+
+/**
+ * @brief Runs the simulation for a fixed number of ticks, as fast as possible and without any video device.
+ *
+ * Every tick advances the game by PF::Global::Model::SIMULATION_STEP_RATE_MS. Since there is no keyboard, the player
+ * is driven either by a recorded session, or by a script that keeps attacking while walking in a square, so the
+ * projectile population ramps up the same way it does in a real session.
+ *
+ * The run is deterministic: the same input over the same number of ticks gives the same state checksum, whatever the
+ * thread count.
+ *
+ * With allocation tracking compiled in, see AllocationTracker.h, the report also counts the heap allocations of the
+ * ticks following the warm-up. Once the population has ramped up, a tick is expected not to allocate at all.
+ *
+ * @param ticks The number of ticks to simulate. Zero, when replaying, simulates the whole recording.
+ * @param threadCount The number of threads updating the entities, zero for one per hardware thread.
+ * @param replay The session to feed back, or nullptr to use the script.
+ * @return The measured throughput and tick latency percentiles.
+ */
+[[nodiscard]] Report runSimulation(std::size_t ticks,
+                                   std::size_t threadCount,
+                                   const PF::InputRecording* replay = nullptr);
+
+/**
+ * @brief Prints a report through the log.
+ */
+void logReport(const Report& report);
+}  // namespace PF::Headless
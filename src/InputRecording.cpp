@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Exceptions.h"
+#include "InputRecording.h"
+
+constexpr std::array<char, 4> RECORDING_MAGIC = {'P', 'F', 'R', 'P'};
+constexpr std::uint32_t RECORDING_VERSION = 1;
+constexpr std::uint8_t VARINT_PAYLOAD_MASK = 0x7F;
+constexpr std::uint8_t VARINT_CONTINUE_BIT = 0x80;
+constexpr unsigned VARINT_PAYLOAD_BITS = 7;
+constexpr unsigned BITS_PER_BYTE = 8;
+constexpr unsigned MAX_VARINT_SHIFT = 63;
+
+namespace
+{
+void WriteUnsigned(std::vector<std::uint8_t>& bytes, std::uint64_t value, std::size_t size)
+{
+    // Little-endian, whatever the host order
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value >> (i * BITS_PER_BYTE)));
+    }
+}
+
+void WriteVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value)
+{
+    while (value > VARINT_PAYLOAD_MASK)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUE_BIT);
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Sequential reader over a loaded file, throwing on truncation.
+ */
+class ByteReader
+{
+  public:
+    ByteReader(const std::vector<std::uint8_t>& bytes, std::string_view filePath): m_bytes(bytes), m_filePath(filePath)
+    {
+    }
+
+    [[nodiscard]] bool atEnd() const { return m_offset == m_bytes.size(); }
+
+    std::uint8_t readByte()
+    {
+        if (atEnd()) { throw PF::Exception(std::format("Truncated input recording: {}", m_filePath)); }
+        return m_bytes[m_offset++];
+    }
+
+    std::uint64_t readUnsigned(std::size_t size)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            value |= static_cast<std::uint64_t>(readByte()) << (i * BITS_PER_BYTE);
+        }
+        return value;
+    }
+
+    std::uint64_t readVarint()
+    {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += VARINT_PAYLOAD_BITS)
+        {
+            if (shift > MAX_VARINT_SHIFT)
+            {
+                throw PF::Exception(std::format("Corrupted input recording: {}", m_filePath));
+            }
+            const std::uint8_t byte = readByte();
+            value |= static_cast<std::uint64_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+            if ((byte & VARINT_CONTINUE_BIT) == 0) { return value; }
+        }
+    }
+
+  private:
+    const std::vector<std::uint8_t>& m_bytes;
+    std::string_view m_filePath;
+    std::size_t m_offset = 0;
+};
+}  // namespace
+
+PF::InputRecording::InputRecording(Uint64 seed, PF::SimdLevel simdLevel): m_seed(seed), m_simdLevel(simdLevel) {}
+
+void PF::InputRecording::record(Uint64 tick, PF::PlayerIntention intention)
+{
+    assert((m_events.empty() || m_events.back().tick <= tick) && "Intentions must be recorded in tick order.");
+    m_events.push_back({.tick = tick, .intention = intention});
+    m_tickCount = std::max(m_tickCount, tick);
+}
+
+void PF::InputRecording::setTickCount(Uint64 tickCount) { m_tickCount = tickCount; }
+
+Uint64 PF::InputRecording::getSeed() const { return m_seed; }
+
+PF::SimdLevel PF::InputRecording::getSimdLevel() const { return m_simdLevel; }
+
+Uint64 PF::InputRecording::getTickCount() const { return m_tickCount; }
+
+const std::vector<PF::InputRecording::Event>& PF::InputRecording::getEvents() const { return m_events; }
+
+void PF::InputRecording::save(std::string_view filePath) const
+{
+    std::vector<std::uint8_t> bytes(RECORDING_MAGIC.begin(), RECORDING_MAGIC.end());
+    WriteUnsigned(bytes, RECORDING_VERSION, sizeof(std::uint32_t));
+    WriteUnsigned(bytes, m_seed, sizeof(std::uint64_t));
+    WriteUnsigned(bytes, static_cast<std::uint64_t>(m_simdLevel), sizeof(std::uint8_t));
+    WriteUnsigned(bytes, m_tickCount, sizeof(std::uint64_t));
+
+    Uint64 previousTick = 0;
+    for (const Event& event : m_events)
+    {
+        WriteVarint(bytes, event.tick - previousTick);
+        bytes.push_back(static_cast<std::uint8_t>(event.intention));
+        previousTick = event.tick;
+    }
+
+    std::ofstream output{std::string{filePath}, std::ios::binary | std::ios::trunc};
+    output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!output) { throw PF::Exception(std::format("Failed to write input recording: {}", filePath)); }
+}
+
+PF::InputRecording PF::InputRecording::load(std::string_view filePath)
+{
+    std::ifstream input{std::string{filePath}, std::ios::binary};
+    if (!input) { throw PF::Exception(std::format("Couldn't open input recording: {}", filePath)); }
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+
+    ByteReader reader(bytes, filePath);
+    for (const char expected : RECORDING_MAGIC)
+    {
+        if (reader.readByte() != static_cast<std::uint8_t>(expected))
+        {
+            throw PF::Exception(std::format("Not an input recording: {}", filePath));
+        }
+    }
+    if (reader.readUnsigned(sizeof(std::uint32_t)) != RECORDING_VERSION)
+    {
+        throw PF::Exception(std::format("Unsupported input recording version: {}", filePath));
+    }
+    const Uint64 seed = reader.readUnsigned(sizeof(std::uint64_t));
+    const auto simdLevel = reader.readUnsigned(sizeof(std::uint8_t));
+    const Uint64 tickCount = reader.readUnsigned(sizeof(std::uint64_t));
+    if (simdLevel >= static_cast<std::uint64_t>(PF::SimdLevel::SimdLevel_Last))
+    {
+        throw PF::Exception(std::format("Corrupted input recording: {}", filePath));
+    }
+
+    InputRecording recording(seed, static_cast<PF::SimdLevel>(simdLevel));
+    Uint64 tick = 0;
+    while (!reader.atEnd())
+    {
+        tick += reader.readVarint();
+        const std::uint8_t intention = reader.readByte();
+        if (intention >= static_cast<std::uint8_t>(PF::PlayerIntention::PlayerIntention_Last))
+        {
+            throw PF::Exception(std::format("Corrupted input recording: {}", filePath));
+        }
+        recording.record(tick, static_cast<PF::PlayerIntention>(intention));
+    }
+    recording.setTickCount(std::max(tickCount, tick));
+    return recording;
+}
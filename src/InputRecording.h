@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Enums.h"
+
+namespace PF
+{
+/**
+ * @class InputRecording
+ * @brief The player intentions of a session, each stamped with the simulation tick it was applied before.
+ *
+ * Together with the game seed and the particle kernel's instruction set, this is everything a session depends on:
+ * feeding the intentions back at the same ticks reproduces the same entities at every tick.
+ *
+ * On disk, a recording is a fixed header followed by one record per intention: the tick delta from the previous
+ * record as an unsigned LEB128 varint, then the intention as one byte. A typical record takes 2 or 3 bytes.
+ */
+class InputRecording
+{
+  public:
+    /**
+     * @struct Event
+     * @brief One intention and the tick it applies to.
+     */
+    struct Event
+    {
+        Uint64 tick = 0;
+        PF::PlayerIntention intention = PF::PlayerIntention::NONE;
+    };
+
+    /**
+     * @param seed The seed of the recorded game.
+     * @param simdLevel The instruction set the particle kernel ran with.
+     */
+    InputRecording(Uint64 seed, PF::SimdLevel simdLevel);
+
+    /**
+     * @brief Appends an intention. Ticks must not decrease from one call to the next.
+     */
+    void record(Uint64 tick, PF::PlayerIntention intention);
+
+    /**
+     * @brief Sets the number of ticks the session lasted, so a replay runs exactly as long.
+     */
+    void setTickCount(Uint64 tickCount);
+
+    [[nodiscard]] Uint64 getSeed() const;
+    [[nodiscard]] PF::SimdLevel getSimdLevel() const;
+    [[nodiscard]] Uint64 getTickCount() const;
+    [[nodiscard]] const std::vector<Event>& getEvents() const;
+
+    /**
+     * @brief Writes the recording to a file.
+     * @throws PF::Exception if the file cannot be written.
+     */
+    void save(std::string_view filePath) const;
+
+    /**
+     * @brief Reads a recording written by save().
+     * @throws PF::Exception if the file cannot be read or is not a valid recording.
+     */
+    [[nodiscard]] static InputRecording load(std::string_view filePath);
+
+  private:
+    Uint64 m_seed;
+    PF::SimdLevel m_simdLevel;
+    Uint64 m_tickCount = 0;
+    std::vector<Event> m_events;  // In tick order
+};
+}  // namespace PF
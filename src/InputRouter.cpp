@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+#include "Enums.h"
+#include "InputRouter.h"
+#include "Log.h"
+
+namespace
+{
+void LogIntentionFromEvent(const SDL_Event& event, const PF::PlayerIntention playerIntention)
+{
+    // Log the player intention and the event type
+    PF_LOG_VERBOSE("Player intention: %s - from SDL_Event: %s | 0x%x",
+                   PF::toString(playerIntention),
+                   SDL_GetKeyName(event.key.key),
+                   event.type);
+}
+}  // namespace
+
+PF::InputRouter::IntentionMask PF::InputRouter::allIntentions()
+{
+    IntentionMask mask;
+    mask.set();
+    mask.reset(static_cast<std::size_t>(PF::PlayerIntention::NONE));
+    return mask;
+}
+
+void PF::InputRouter::subscribe(PF::IntentionReceiver& receiver, IntentionMask intentions)
+{
+    const auto found = std::ranges::find(m_subscriptions, &receiver, &Subscription::receiver);
+    if (found != m_subscriptions.end())
+    {
+        found->intentions = intentions;
+        return;
+    }
+    m_subscriptions.push_back({&receiver, intentions});
+}
+
+PF::PlayerIntention PF::InputRouter::handleEvent(const SDL_Event& event)
+{
+    if (event.type != SDL_EVENT_KEY_DOWN && event.type != SDL_EVENT_KEY_UP) { return PF::PlayerIntention::NONE; }
+
+    const std::size_t binding = findBinding(event.key.key);
+    if (binding == DEFAULT_BINDINGS.size()) { return PF::PlayerIntention::NONE; }
+
+    // Repeats, and presses or releases the key state already reflects, would only repeat an intention
+    const bool down = event.type == SDL_EVENT_KEY_DOWN;
+    if (m_keyDown.test(binding) == down)
+    {
+        ++m_coalescedCount;
+        return PF::PlayerIntention::NONE;
+    }
+
+    m_keyDown.set(binding, down);
+
+    const KeyBinding& keyBinding = DEFAULT_BINDINGS[binding];
+    const PF::PlayerIntention playerIntention = down ? keyBinding.press : keyBinding.release;
+    LogIntentionFromEvent(event, playerIntention);
+    m_pending.push_back(playerIntention);
+    return playerIntention;
+}
+
+void PF::InputRouter::push(PF::PlayerIntention playerIntention)
+{
+    if (playerIntention == PF::PlayerIntention::NONE) { return; }
+    m_pending.push_back(playerIntention);
+}
+
+std::span<const PF::PlayerIntention> PF::InputRouter::dispatch()
+{
+    // Swap rather than copy, both buffers keep their capacity from tick to tick
+    m_delivered.clear();
+    m_delivered.swap(m_pending);
+
+    for (const auto intention : m_delivered)
+    {
+        const auto bit = static_cast<std::size_t>(intention);
+        for (const Subscription& subscription : m_subscriptions)
+        {
+            if (subscription.intentions.test(bit)) { subscription.receiver->receiveIntention(intention); }
+        }
+    }
+    return m_delivered;
+}
+
+std::size_t PF::InputRouter::getCoalescedCount() const { return m_coalescedCount; }
+
+std::size_t PF::InputRouter::findBinding(SDL_Keycode key)
+{
+    const auto found = std::ranges::find(DEFAULT_BINDINGS, key, &KeyBinding::key);
+    return static_cast<std::size_t>(std::distance(DEFAULT_BINDINGS.begin(), found));
+}
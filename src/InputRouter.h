@@ -0,0 +1,117 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Enums.h"
+
+namespace PF
+{
+/**
+ * @class IntentionReceiver
+ * @brief Anything that reacts to player intentions, e.g. the player store. Subscribe it to an InputRouter.
+ */
+class IntentionReceiver
+{
+  public:
+    IntentionReceiver() = default;
+    virtual ~IntentionReceiver() = default;
+
+    IntentionReceiver(const IntentionReceiver&) = default;
+    IntentionReceiver& operator=(const IntentionReceiver&) = default;
+    IntentionReceiver(IntentionReceiver&&) = default;
+    IntentionReceiver& operator=(IntentionReceiver&&) = default;
+
+    virtual void receiveIntention(PF::PlayerIntention playerIntention) = 0;
+};
+
+/**
+ * @class InputRouter
+ * @brief Turns keyboard events into intentions, and delivers them once per tick to the receivers that asked for them.
+ *
+ * Events only update the state of the bound keys and queue intentions; nothing reaches the game until dispatch().
+ * Events that do not change a key's state, such as key repeats, are dropped. A key pressed and released within the
+ * same tick queues both intentions, in order, so a quick tap still attacks or moves. The cost of input is therefore a
+ * few intentions per tick, delivered to a few receivers, whatever the number of entities alive.
+ */
+class InputRouter
+{
+  public:
+    using IntentionMask = std::bitset<static_cast<std::size_t>(PF::PlayerIntention::PlayerIntention_Last)>;
+
+    /**
+     * @struct KeyBinding
+     * @brief The intentions a key queues when pressed and when released.
+     */
+    struct KeyBinding
+    {
+        SDL_Keycode key;
+        PF::PlayerIntention press;
+        PF::PlayerIntention release;
+    };
+
+    static constexpr std::array<KeyBinding, 5> DEFAULT_BINDINGS = {
+        {{SDLK_UP, PF::PlayerIntention::MOVE_UP, PF::PlayerIntention::MOVE_STOP_UP},
+         {SDLK_DOWN, PF::PlayerIntention::MOVE_DOWN, PF::PlayerIntention::MOVE_STOP_DOWN},
+         {SDLK_LEFT, PF::PlayerIntention::MOVE_LEFT, PF::PlayerIntention::MOVE_STOP_LEFT},
+         {SDLK_RIGHT, PF::PlayerIntention::MOVE_RIGHT, PF::PlayerIntention::MOVE_STOP_RIGHT},
+         {SDLK_Q, PF::PlayerIntention::ATTACK, PF::PlayerIntention::ATTACK_STOP}}
+    };
+
+    /**
+     * @brief Gets a mask selecting every intention.
+     */
+    [[nodiscard]] static IntentionMask allIntentions();
+
+    /**
+     * @brief Delivers the intentions selected by `intentions` to `receiver` from the next dispatch() on. Subscribing
+     * a receiver again replaces its mask. The receiver must outlive the subscription.
+     */
+    void subscribe(PF::IntentionReceiver& receiver, IntentionMask intentions);
+
+    /**
+     * @brief Updates the key state from a keyboard event, and queues the intention it is bound to.
+     * @return The intention queued, or PlayerIntention::NONE if the event was unbound or changed nothing.
+     */
+    PF::PlayerIntention handleEvent(const SDL_Event& event);
+
+    /**
+     * @brief Queues an intention as is, e.g. from a script or a recording, bypassing key state and coalescing.
+     */
+    void push(PF::PlayerIntention playerIntention);
+
+    /**
+     * @brief Delivers the queued intentions, in order, to the receivers subscribed to them, and starts a new tick.
+     * @return The intentions delivered, valid until the next call.
+     */
+    std::span<const PF::PlayerIntention> dispatch();
+
+    /**
+     * @brief Gets the number of keyboard events dropped since construction.
+     */
+    [[nodiscard]] std::size_t getCoalescedCount() const;
+
+  private:
+    struct Subscription
+    {
+        PF::IntentionReceiver* receiver;
+        IntentionMask intentions;
+    };
+
+    using KeyMask = std::bitset<DEFAULT_BINDINGS.size()>;
+
+    [[nodiscard]] static std::size_t findBinding(SDL_Keycode key);  // Index in DEFAULT_BINDINGS, or its size
+
+  private:
+    std::vector<Subscription> m_subscriptions;     // Receivers and the intentions they asked for
+    std::vector<PF::PlayerIntention> m_pending;    // Intentions queued for the next dispatch()
+    std::vector<PF::PlayerIntention> m_delivered;  // Intentions of the last dispatch()
+    KeyMask m_keyDown;                             // Bound keys held right now
+    std::size_t m_coalescedCount = 0;              // Keyboard events that never became an intention
+};
+}  // namespace PF
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include "JobSystem.h"
+
+PF::JobSystem::JobSystem(std::size_t threadCount)
+{
+    if (threadCount == 0) { threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency()); }
+
+    m_queues.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) { m_queues.push_back(std::make_unique<WorkQueue>()); }
+
+    // Queue 0 belongs to the thread calling parallelFor, so one less worker is needed
+    m_workers.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; ++i)
+    {
+        m_workers.emplace_back([this, i](const std::stop_token& stopToken) { workerLoop(stopToken, i); });
+    }
+}
+
+PF::JobSystem::~JobSystem()
+{
+    for (auto& worker : m_workers) { worker.request_stop(); }
+    m_wake.notify_all();
+    // The jthreads join on destruction
+}
+
+std::size_t PF::JobSystem::getThreadCount() const { return m_queues.size(); }
+
+void PF::JobSystem::dispatch(Task task, std::size_t count, std::size_t chunkSize)
+{
+    assert(chunkSize > 0 && "Chunk size must be greater than zero.");
+    const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    // Publish the task and the chunk count before any chunk becomes visible: a worker still draining the previous
+    // dispatch may pick up a new chunk before it sees the new generation
+    m_task = task;
+    m_pendingChunks.store(chunkCount, std::memory_order_release);
+
+    // Deal contiguous runs of chunks to each queue, so owners walk memory linearly until they have to steal
+    const std::size_t queueCount = m_queues.size();
+    const std::size_t chunksPerQueue = (chunkCount + queueCount - 1) / queueCount;
+    for (std::size_t q = 0; q < queueCount; ++q)
+    {
+        auto& queue = *m_queues[q];
+        const std::scoped_lock lock(queue.mutex);
+        queue.chunks.clear();
+        queue.head = 0;
+        const std::size_t firstChunk = q * chunksPerQueue;
+        const std::size_t lastChunk = std::min(firstChunk + chunksPerQueue, chunkCount);
+        // Pushed in reverse so the owner, popping from the back, starts with the lowest indices
+        for (std::size_t c = lastChunk; c > firstChunk; --c)
+        {
+            const std::size_t begin = (c - 1) * chunkSize;
+            queue.chunks.push_back({begin, std::min(begin + chunkSize, count)});
+        }
+    }
+
+    {
+        const std::scoped_lock lock(m_wakeMutex);
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    // Help out, then wait for the chunks other threads are still running
+    while (runOne(0)) {}
+    while (m_pendingChunks.load(std::memory_order_acquire) > 0) { std::this_thread::yield(); }
+}
+
+void PF::JobSystem::workerLoop(const std::stop_token& stopToken, std::size_t queueIndex)
+{
+    std::size_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_wakeMutex);
+            if (!m_wake.wait(lock, stopToken, [&] { return m_generation != seenGeneration; })) { return; }
+            seenGeneration = m_generation;
+        }
+
+        // Every chunk is queued before the wake-up, so once all queues are empty this dispatch has nothing left
+        while (runOne(queueIndex)) {}
+    }
+}
+
+bool PF::JobSystem::runOne(std::size_t queueIndex)
+{
+    Chunk chunk;
+    if (!pop(queueIndex, chunk) && !steal(queueIndex, chunk)) { return false; }
+
+    m_task.function(m_task.context, chunk.begin, chunk.end);
+    m_pendingChunks.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool PF::JobSystem::pop(std::size_t queueIndex, Chunk& chunk)
+{
+    auto& queue = *m_queues[queueIndex];
+    const std::scoped_lock lock(queue.mutex);
+    if (queue.head == queue.chunks.size()) { return false; }
+
+    chunk = queue.chunks.back();
+    queue.chunks.pop_back();
+    return true;
+}
+
+bool PF::JobSystem::steal(std::size_t queueIndex, Chunk& chunk)
+{
+    // Start with the next queue rather than always the first one, to spread thieves over victims
+    const std::size_t queueCount = m_queues.size();
+    for (std::size_t offset = 1; offset < queueCount; ++offset)
+    {
+        auto& queue = *m_queues[(queueIndex + offset) % queueCount];
+        const std::scoped_lock lock(queue.mutex);
+        if (queue.head == queue.chunks.size()) { continue; }
+
+        chunk = queue.chunks[queue.head++];
+        return true;
+    }
+    return false;
+}
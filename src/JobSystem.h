@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace PF
+{
+/**
+ * @class JobSystem
+ * @brief Fixed pool of worker threads that split data-parallel loops into chunks, with work stealing.
+ *
+ * Each thread owns a deque of chunks. Owners pop from the back of their own deque, and idle threads steal from the
+ * front of the others, so uneven chunks even out without a central queue. The thread calling parallelFor() takes
+ * part as worker 0 and only returns once every chunk is done.
+ *
+ * Chunks of one parallelFor() may run in any order and on any thread. Callers that need a deterministic result must
+ * make every chunk independent, and merge the per-chunk results in chunk order afterwards.
+ */
+class JobSystem
+{
+  public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount The total number of threads to use, including the calling thread. Zero picks one thread
+     * per hardware thread.
+     */
+    explicit JobSystem(std::size_t threadCount = 0);
+    ~JobSystem();
+
+    // Deleted copy and move constructors and assignment operators
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    /**
+     * @brief Calls `function(begin, end)` over [0, count) split in chunks of `chunkSize`, on every thread.
+     *
+     * Small loops run inline on the calling thread. `function` must not throw.
+     *
+     * @param count The number of elements to process.
+     * @param chunkSize The number of elements per chunk. Must be greater than zero.
+     * @param function The callable invoked for each chunk.
+     */
+    template<typename Function>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Function&& function)
+    {
+        if (count == 0) { return; }
+        if (count <= chunkSize || m_workers.empty())
+        {
+            function(std::size_t{0}, count);
+            return;
+        }
+
+        using Callable = std::remove_reference_t<Function>;
+        const Task task = {.function = [](void* context, std::size_t begin, std::size_t end)
+                           { (*static_cast<Callable*>(context))(begin, end); },
+                           .context = const_cast<void*>(static_cast<const void*>(&function))};
+        dispatch(task, count, chunkSize);
+    }
+
+    /**
+     * @brief Gets the number of threads taking part in parallel loops, including the calling thread.
+     */
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+  private:
+    struct Task
+    {
+        void (*function)(void*, std::size_t, std::size_t) = nullptr;
+        void* context = nullptr;
+    };
+
+    struct Chunk
+    {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::vector<Chunk> chunks;  // Reused across loops, so steady-state dispatch does not allocate
+        std::size_t head = 0;       // Thieves take chunks from here, the owner pops from the back
+    };
+
+    void dispatch(Task task, std::size_t count, std::size_t chunkSize);
+    void workerLoop(const std::stop_token& stopToken, std::size_t queueIndex);
+
+    // Runs one chunk from the given queue, or stolen from another one. Returns false when every queue is empty.
+    bool runOne(std::size_t queueIndex);
+    bool pop(std::size_t queueIndex, Chunk& chunk);
+    bool steal(std::size_t queueIndex, Chunk& chunk);
+
+  private:
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;  // One per thread, index 0 belongs to the calling thread
+    Task m_task;                                       // Loop body of the current dispatch
+    std::atomic<std::size_t> m_pendingChunks{0};       // Chunks of the current dispatch not finished yet
+
+    std::mutex m_wakeMutex;
+    std::condition_variable_any m_wake;  // Signals workers that a new dispatch started
+    std::size_t m_generation = 0;        // Incremented on every dispatch
+
+    std::vector<std::jthread> m_workers;  // Declared last so the threads stop before the state they use goes away
+};
+}  // namespace PF
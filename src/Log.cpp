@@ -0,0 +1,300 @@
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Enums.h"
+#include "Log.h"
+
+constexpr std::chrono::milliseconds IDLE_SLEEP{2};  // Background thread pause when the queue is empty
+constexpr std::size_t MAX_SPEC_SIZE = 32;           // Longest printf conversion spec rewritten per argument
+
+static_assert(std::has_single_bit(PF::Log::QUEUE_CAPACITY), "Log queue capacity must be a power of two");
+
+namespace
+{
+/**
+ * @class RecordQueue
+ * @brief Bounded multi-producer, single-consumer queue of log records.
+ *
+ * Every cell carries a sequence number telling whose turn it is: producers claim a position with a CAS on the
+ * enqueue counter and publish the cell by bumping its sequence; the consumer frees it by bumping it once more, a
+ * whole lap ahead. No thread ever waits on another, and a full queue simply refuses the record.
+ */
+class RecordQueue
+{
+  public:
+    RecordQueue()
+    {
+        for (std::size_t i = 0; i < PF::Log::QUEUE_CAPACITY; ++i) { m_cells[i].sequence.store(i); }
+    }
+
+    bool push(const PF::Log::Record& record)
+    {
+        std::size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = m_cells[position & MASK];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0)
+            {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.record = record;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0) { return false; }  // The consumer has not freed this cell yet: full
+            else { position = m_enqueuePosition.load(std::memory_order_relaxed); }
+        }
+    }
+
+    bool pop(PF::Log::Record& record)
+    {
+        Cell& cell = m_cells[m_dequeuePosition & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1) { return false; }
+
+        record = cell.record;
+        cell.sequence.store(m_dequeuePosition + PF::Log::QUEUE_CAPACITY, std::memory_order_release);
+        ++m_dequeuePosition;
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of records claimed by producers so far, including the ones still being copied in.
+     */
+    [[nodiscard]] std::size_t getEnqueuePosition() const { return m_enqueuePosition.load(std::memory_order_acquire); }
+
+  private:
+    static constexpr std::size_t MASK = PF::Log::QUEUE_CAPACITY - 1;
+
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> sequence;
+        PF::Log::Record record;
+    };
+
+    std::array<Cell, PF::Log::QUEUE_CAPACITY> m_cells;
+    alignas(64) std::atomic<std::size_t> m_enqueuePosition{0};  // Next position a producer claims
+    alignas(64) std::size_t m_dequeuePosition = 0;              // Next position the consumer reads, consumer only
+};
+
+SDL_LogPriority ToPriority(const PF::LogLevel level)
+{
+    switch (level)
+    {
+        case PF::LogLevel::VERBOSE: return SDL_LOG_PRIORITY_VERBOSE;
+        case PF::LogLevel::INFO: return SDL_LOG_PRIORITY_INFO;
+        case PF::LogLevel::WARNING: return SDL_LOG_PRIORITY_WARN;
+        case PF::LogLevel::CRITICAL: return SDL_LOG_PRIORITY_CRITICAL;
+        case PF::LogLevel::LogLevel_Last: break;
+    }
+    return SDL_LOG_PRIORITY_INFO;
+}
+
+/**
+ * @brief Formats one argument with its printf conversion spec, rewritten to match the type it was recorded with.
+ *
+ * `spec` holds the flags, width and precision of the original conversion without its length modifier, e.g. "%-8.2"
+ * for "%-8.2zu". Integers are always passed as 64-bit, so they get an "ll" modifier whatever the call site wrote.
+ */
+void AppendArgument(std::string& line,
+                    const PF::Log::Record& record,
+                    std::size_t index,
+                    std::string spec,
+                    const char conversion)
+{
+    const std::uint64_t value = record.values[index];
+    std::array<char, 256> buffer{};
+    switch (record.kinds[index])
+    {
+        case PF::Log::ArgumentKind::SIGNED:
+        case PF::Log::ArgumentKind::UNSIGNED:
+        {
+            if (conversion == 'c')
+            {
+                spec += 'c';
+                SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), static_cast<int>(value));
+                break;
+            }
+            const bool isSigned = record.kinds[index] == PF::Log::ArgumentKind::SIGNED;
+            const bool integerConversion = std::string_view{"diouxX"}.find(conversion) != std::string_view::npos;
+            spec += "ll";
+            spec += integerConversion ? conversion : (isSigned ? 'd' : 'u');
+            if (isSigned) { SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), static_cast<long long>(value)); }
+            else { SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), static_cast<unsigned long long>(value)); }
+            break;
+        }
+        case PF::Log::ArgumentKind::FLOATING:
+        {
+            const bool floatConversion = std::string_view{"fFeEgGaA"}.find(conversion) != std::string_view::npos;
+            spec += floatConversion ? conversion : 'f';
+            SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), std::bit_cast<double>(value));
+            break;
+        }
+        case PF::Log::ArgumentKind::POINTER:
+        {
+            spec += 'p';
+            SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), reinterpret_cast<void*>(value));
+            break;
+        }
+        case PF::Log::ArgumentKind::STRING:
+        {
+            spec += 's';
+            SDL_snprintf(buffer.data(), buffer.size(), spec.c_str(), record.text.data() + value);
+            break;
+        }
+    }
+    line += buffer.data();
+}
+
+std::string Format(const PF::Log::Record& record)
+{
+    std::string line;
+    std::size_t argument = 0;
+    for (const char* cursor = record.format; *cursor != '\0'; ++cursor)
+    {
+        if (*cursor != '%')
+        {
+            line += *cursor;
+            continue;
+        }
+        if (cursor[1] == '%')
+        {
+            line += '%';
+            ++cursor;
+            continue;
+        }
+
+        // Keep the flags, width and precision, drop the length modifier
+        std::string spec = "%";
+        ++cursor;
+        while (*cursor != '\0' && std::strchr("-+ #0123456789.", *cursor) != nullptr && spec.size() < MAX_SPEC_SIZE)
+        {
+            spec += *cursor++;
+        }
+        while (*cursor != '\0' && std::strchr("hlzjtL", *cursor) != nullptr) { ++cursor; }
+        if (*cursor == '\0') { break; }
+
+        if (argument < record.argumentCount) { AppendArgument(line, record, argument++, spec, *cursor); }
+        else { line += "(missing)"; }
+    }
+
+    if (record.suppressed > 0)
+    {
+        line += " (+" + std::to_string(record.suppressed) + " similar messages suppressed)";
+    }
+    return line;
+}
+
+/**
+ * @class Backend
+ * @brief Owns the queue and the thread turning its records into SDL log messages.
+ */
+class Backend
+{
+  public:
+    Backend(): m_writer([this](std::stop_token stopToken) { run(stopToken); }) {}
+
+    void submit(const PF::Log::Record& record)
+    {
+        if (!m_queue.push(record)) { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    void flush() const
+    {
+        const std::size_t target = m_queue.getEnqueuePosition();
+        while (m_written.load(std::memory_order_acquire) < target) { std::this_thread::sleep_for(IDLE_SLEEP / 2); }
+    }
+
+    [[nodiscard]] std::size_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+  private:
+    void run(const std::stop_token& stopToken)
+    {
+        std::size_t reportedDropped = 0;
+        PF::Log::Record record;
+        while (true)
+        {
+            if (m_queue.pop(record))
+            {
+                SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, ToPriority(record.level), "%s", Format(record).c_str());
+                m_written.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+
+            const std::size_t dropped = getDroppedCount();
+            if (dropped != reportedDropped)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Log queue full: %zu messages dropped so far", dropped);
+                reportedDropped = dropped;
+            }
+
+            // Drain everything queued before the stop request, then leave
+            if (stopToken.stop_requested()) { return; }
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+
+    RecordQueue m_queue;
+    std::atomic<std::size_t> m_written{0};  // Records handed to SDL so far, which flush() waits for
+    std::atomic<std::size_t> m_dropped{0};  // Records refused because the queue was full
+    std::jthread m_writer;  // Declared last: it starts once the queue exists, and stops before it is destroyed
+};
+
+Backend& GetBackend()
+{
+    // Started on the first message, stopped after draining the queue when the program exits
+    static Backend backend;
+    return backend;
+}
+}  // namespace
+
+bool PF::Log::RateLimiter::allow(Uint64 nowNs, std::uint32_t& suppressed)
+{
+    const Uint64 window = nowNs / SDL_NS_PER_SECOND;
+    Uint64 current = m_window.load(std::memory_order_relaxed);
+    if (current != window && m_window.compare_exchange_strong(current, window, std::memory_order_relaxed))
+    {
+        m_count.store(0, std::memory_order_relaxed);
+    }
+
+    if (m_count.fetch_add(1, std::memory_order_relaxed) >= MESSAGES_PER_SECOND)
+    {
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void PF::Log::Detail::submit(const Record& record) { GetBackend().submit(record); }
+
+void PF::Log::Detail::Encode(Record& record, std::string_view argument)
+{
+    const std::size_t index = record.argumentCount++;
+    const std::size_t offset = record.textSize;
+    const std::size_t size = std::min(argument.size(), TEXT_CAPACITY - offset - 1);  // Room for the terminator
+    std::memcpy(record.text.data() + offset, argument.data(), size);
+    record.text[offset + size] = '\0';
+
+    record.kinds[index] = ArgumentKind::STRING;
+    record.values[index] = offset;
+    record.textSize = static_cast<std::uint16_t>(std::min(offset + size + 1, TEXT_CAPACITY - 1));
+}
+
+void PF::Log::flush() { GetBackend().flush(); }
+
+std::size_t PF::Log::getDroppedCount() { return GetBackend().getDroppedCount(); }
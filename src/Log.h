@@ -0,0 +1,193 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "Enums.h"
+
+#define PF_LOG_LEVEL_VERBOSE 0
+#define PF_LOG_LEVEL_INFO 1
+#define PF_LOG_LEVEL_WARNING 2
+#define PF_LOG_LEVEL_CRITICAL 3
+
+#ifndef PF_LOG_MIN_LEVEL
+#define PF_LOG_MIN_LEVEL PF_LOG_LEVEL_VERBOSE
+#endif
+
+/**
+ * @brief Logs a printf-style message at `level`, e.g. PF_LOG(PF::LogLevel::INFO, "Loaded %s", path).
+ *
+ * Messages below PF_LOG_MIN_LEVEL (CMake option PERFECTFORM_LOG_LEVEL) are discarded at compile time, arguments
+ * included. Every call site has its own rate limit.
+ */
+#define PF_LOG(level, ...)                                                                                             \
+    do {                                                                                                               \
+        if constexpr (static_cast<int>(level) >= PF_LOG_MIN_LEVEL)                                                     \
+        {                                                                                                              \
+            static PF::Log::RateLimiter pfLogRateLimiter;                                                              \
+            PF::Log::write(pfLogRateLimiter, level, __VA_ARGS__);                                                      \
+        }                                                                                                              \
+    } while (false)
+
+#define PF_LOG_VERBOSE(...) PF_LOG(PF::LogLevel::VERBOSE, __VA_ARGS__)
+#define PF_LOG_INFO(...) PF_LOG(PF::LogLevel::INFO, __VA_ARGS__)
+#define PF_LOG_WARNING(...) PF_LOG(PF::LogLevel::WARNING, __VA_ARGS__)
+#define PF_LOG_CRITICAL(...) PF_LOG(PF::LogLevel::CRITICAL, __VA_ARGS__)
+
+/**
+ * @brief Asynchronous logging.
+ *
+ * A call site only copies its arguments into a fixed-size record and pushes it onto a bounded lock-free queue: no
+ * formatting, allocation or I/O happens on the calling thread. A background thread pops the records, formats them
+ * with the printf-style format string, and writes them through SDL_LogMessage.
+ *
+ * Strings are copied into the record, up to TEXT_CAPACITY bytes in total, so a temporary std::string or the result
+ * of SDL_GetKeyName() may be passed. The format string itself must be a string literal. When the queue is full, the
+ * record is dropped and counted, so a logging burst never blocks the simulation.
+ */
+namespace PF::Log
+{
+constexpr std::size_t QUEUE_CAPACITY = 1024;      // Records in flight, must be a power of two
+constexpr std::size_t MAX_ARGUMENTS = 8;          // Arguments a single message may take
+constexpr std::size_t TEXT_CAPACITY = 160;        // Bytes of string arguments a single message may copy
+constexpr std::uint32_t MESSAGES_PER_SECOND = 20;  // Messages a single call site may log every second
+
+/**
+ * @class RateLimiter
+ * @brief Lets a call site through at most MESSAGES_PER_SECOND times per second. Use through PF_LOG.
+ */
+class RateLimiter
+{
+  public:
+    /**
+     * @param nowNs The current time, e.g. from SDL_GetTicksNS().
+     * @param suppressed Receives, when allowed, the number of messages suppressed since the last allowed one.
+     */
+    bool allow(Uint64 nowNs, std::uint32_t& suppressed);
+
+  private:
+    std::atomic<Uint64> m_window{0};            // Current one-second window, since SDL initialization
+    std::atomic<std::uint32_t> m_count{0};      // Messages seen in the current window
+    std::atomic<std::uint32_t> m_suppressed{0};  // Messages suppressed since the last allowed one
+};
+
+/**
+ * @struct FormatString
+ * @brief A printf-style format string known at compile time, so records can keep a pointer to it.
+ */
+struct FormatString
+{
+    template<std::size_t N>
+    consteval FormatString(const char (&literal)[N]): text(literal)  // Implicit, so call sites pass a plain literal
+    {
+    }
+
+    const char* text;
+};
+
+enum class ArgumentKind : std::uint8_t
+{
+    SIGNED,
+    UNSIGNED,
+    FLOATING,
+    POINTER,
+    STRING  // Value holds the offset of the null-terminated copy in the record's text
+};
+
+/**
+ * @struct Record
+ * @brief A message waiting to be formatted: the format string, and its arguments encoded as raw 64-bit values.
+ */
+struct Record
+{
+    const char* format = nullptr;
+    PF::LogLevel level = PF::LogLevel::INFO;
+    std::uint8_t argumentCount = 0;
+    std::uint16_t textSize = 0;
+    std::uint32_t suppressed = 0;  // Messages of the same call site skipped by its rate limit before this one
+    std::array<ArgumentKind, MAX_ARGUMENTS> kinds{};
+    std::array<std::uint64_t, MAX_ARGUMENTS> values{};
+    std::array<char, TEXT_CAPACITY> text{};
+};
+
+namespace Detail
+{
+/**
+ * @brief Pushes a record onto the queue, or counts it as dropped when the queue is full. Never blocks.
+ */
+void submit(const Record& record);
+
+/**
+ * @brief Copies a string argument into the record's text, truncated to the space left.
+ */
+void Encode(Record& record, std::string_view argument);
+
+inline void Encode(Record& record, const char* argument)
+{
+    PF::Log::Detail::Encode(record, argument != nullptr ? std::string_view{argument} : std::string_view{"(null)"});
+}
+
+template<typename T>
+    requires std::is_arithmetic_v<T> || (std::is_pointer_v<T> && !std::is_convertible_v<T, const char*>)
+void Encode(Record& record, const T argument)
+{
+    const std::size_t index = record.argumentCount++;
+    if constexpr (std::is_pointer_v<T>)
+    {
+        record.kinds[index] = ArgumentKind::POINTER;
+        record.values[index] = reinterpret_cast<std::uintptr_t>(argument);
+    }
+    else if constexpr (std::floating_point<T>)
+    {
+        record.kinds[index] = ArgumentKind::FLOATING;
+        record.values[index] = std::bit_cast<std::uint64_t>(static_cast<double>(argument));
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        record.kinds[index] = ArgumentKind::SIGNED;
+        record.values[index] = static_cast<std::uint64_t>(static_cast<std::int64_t>(argument));
+    }
+    else
+    {
+        record.kinds[index] = ArgumentKind::UNSIGNED;
+        record.values[index] = static_cast<std::uint64_t>(argument);
+    }
+}
+}  // namespace Detail
+
+/**
+ * @brief Queues a message. Prefer the PF_LOG macros, which add compile-time filtering and a per-call-site limiter.
+ */
+template<typename... Args>
+void write(RateLimiter& rateLimiter, PF::LogLevel level, FormatString format, const Args&... arguments)
+{
+    static_assert(sizeof...(Args) <= MAX_ARGUMENTS, "Too many log arguments");
+
+    Record record;
+    if (!rateLimiter.allow(SDL_GetTicksNS(), record.suppressed)) { return; }
+
+    record.format = format.text;
+    record.level = level;
+    (Detail::Encode(record, arguments), ...);
+    Detail::submit(record);
+}
+
+/**
+ * @brief Blocks until every message queued so far is written. Call before exiting, or before reporting a fatal error
+ * synchronously, so the log stays in order.
+ */
+void flush();
+
+/**
+ * @brief Gets the number of messages dropped because the queue was full.
+ */
+[[nodiscard]] std::size_t getDroppedCount();
+}  // namespace PF::Log
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "Camera.h"
+#include "JobSystem.h"
+#include "ParticleEmitter.h"
+#include "ParticleKernel.h"
+#include "Profiler.h"
+#include "RenderSnapshot.h"
+
+constexpr std::size_t PARTICLE_UPDATE_CHUNK_SIZE = 4096;  // Particles per job, a multiple of every SIMD width
+constexpr float RADIANS_TO_ROTATION = 180.0F;             // Degrees of rotation a particle turns per radian of angle
+
+void PF::ParticleColumns::resize(std::size_t capacity)
+{
+    positionX.resize(capacity);
+    positionY.resize(capacity);
+    previousX.resize(capacity);
+    previousY.resize(capacity);
+    velocityX.resize(capacity);
+    velocityY.resize(capacity);
+    size.resize(capacity);
+    angle.resize(capacity);
+    randomState.resize(capacity);
+}
+
+void PF::ParticleColumns::move(std::size_t from, std::size_t to)
+{
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    previousX[to] = previousX[from];
+    previousY[to] = previousY[from];
+    velocityX[to] = velocityX[from];
+    velocityY[to] = velocityY[from];
+    size[to] = size[from];
+    angle[to] = angle[from];
+    randomState[to] = randomState[from];
+}
+
+PF::ParticleEmitter::ParticleEmitter(const PF::EmitterConfig& config): m_config(config)
+{
+    assert(m_config.capacity > 0 && "Emitter capacity must be greater than zero.");
+    m_columns.resize(m_config.capacity);
+    m_random.resize(m_config.capacity);
+}
+
+void PF::ParticleEmitter::setLimit(std::size_t capacity, PF::PoolOverflowPolicy overflowPolicy)
+{
+    assert(capacity > 0 && "Emitter capacity must be greater than zero.");
+
+    // Unroll the ring into fresh columns, keeping the newest particles that fit
+    const std::size_t kept = std::min(m_count, capacity);
+    PF::ParticleColumns columns;
+    columns.resize(capacity);
+    for (std::size_t age = m_count - kept; age < m_count; ++age)
+    {
+        const std::size_t from = getSlot(age);
+        const std::size_t to = age - (m_count - kept);
+        columns.positionX[to] = m_columns.positionX[from];
+        columns.positionY[to] = m_columns.positionY[from];
+        columns.previousX[to] = m_columns.previousX[from];
+        columns.previousY[to] = m_columns.previousY[from];
+        columns.velocityX[to] = m_columns.velocityX[from];
+        columns.velocityY[to] = m_columns.velocityY[from];
+        columns.size[to] = m_columns.size[from];
+        columns.angle[to] = m_columns.angle[from];
+        columns.randomState[to] = m_columns.randomState[from];
+    }
+
+    m_columns = std::move(columns);
+    m_random.resize(capacity);
+    m_config.capacity = capacity;
+    m_config.overflowPolicy = overflowPolicy;
+    m_head = 0;
+    m_count = kept;
+}
+
+std::optional<std::size_t> PF::ParticleEmitter::spawn(SDL_FPoint position,
+                                                      SDL_FPoint velocity,
+                                                      float size,
+                                                      Uint64 seed)
+{
+    if (m_count >= m_config.capacity)
+    {
+        ++m_overflowCount;
+        if (m_config.overflowPolicy != PF::PoolOverflowPolicy::RECYCLE_OLDEST) { return std::nullopt; }
+
+        // The oldest particle is always at the head: retiring it only moves the head
+        m_head = getSlot(1);
+        --m_count;
+    }
+
+    const std::size_t slot = getSlot(m_count);
+    m_columns.positionX[slot] = m_columns.previousX[slot] = position.x;
+    m_columns.positionY[slot] = m_columns.previousY[slot] = position.y;
+    m_columns.velocityX[slot] = velocity.x;
+    m_columns.velocityY[slot] = velocity.y;
+    m_columns.size[slot] = size;
+    m_columns.angle[slot] = 0.0F;
+    m_columns.randomState[slot] = seed;
+    ++m_count;
+    m_highWaterMark = std::max(m_highWaterMark, m_count);
+    return slot;
+}
+
+void PF::ParticleEmitter::emit(SDL_FPoint position, SDL_FPoint velocity, float size, Uint64& randomState)
+{
+    const auto jitter = [this, &randomState]
+    {
+        const float factor = m_config.speedJitterMin + (SDL_randf_r(&randomState) * m_config.speedJitterRange);
+        return m_config.speedMultiplier * factor;
+    };
+    velocity.x *= jitter();
+    velocity.y *= jitter();
+
+    // Particles get their own generator, derived from the source's one so the whole tree follows a single seed
+    const Uint64 seed = (static_cast<Uint64>(SDL_rand_bits_r(&randomState)) << 32U) | SDL_rand_bits_r(&randomState);
+    spawn(position, velocity, size * m_config.sizeFactor, seed);
+}
+
+void PF::ParticleEmitter::update(Uint64 stepMs, PF::JobSystem& jobSystem, PF::SimdLevel simdLevel)
+{
+    const auto updateSlots = [this, stepMs, simdLevel](std::size_t begin, std::size_t end)
+    {
+        // Random angle increments are drawn before the kernel runs, from each particle's own generator, so every
+        // SIMD level and thread count sees the same sequence
+        for (std::size_t slot = begin; slot < end; ++slot)
+        {
+            m_columns.previousX[slot] = m_columns.positionX[slot];
+            m_columns.previousY[slot] = m_columns.positionY[slot];
+            m_random[slot] = SDL_randf_r(&m_columns.randomState[slot]);
+        }
+
+        const PF::ParticleKernel::Batch batch = {.positionX = m_columns.positionX.data() + begin,
+                                                 .positionY = m_columns.positionY.data() + begin,
+                                                 .velocityX = m_columns.velocityX.data() + begin,
+                                                 .velocityY = m_columns.velocityY.data() + begin,
+                                                 .size = m_columns.size.data() + begin,
+                                                 .angle = m_columns.angle.data() + begin,
+                                                 .random = m_random.data() + begin,
+                                                 .count = end - begin};
+        PF::ParticleKernel::update(batch, m_config.motion, static_cast<float>(stepMs), simdLevel);
+    };
+
+    jobSystem.parallelFor(m_count,
+                          PARTICLE_UPDATE_CHUNK_SIZE,
+                          [this, &updateSlots](std::size_t begin, std::size_t end)
+                          {
+                              PF_PROFILE_ZONE("ParticleEmitter::update chunk");
+
+                              // A chunk of the ring is one run of slots, or two when it wraps past the last slot
+                              const std::size_t first = getSlot(begin);
+                              const std::size_t length = end - begin;
+                              const std::size_t untilWrap = std::min(length, m_config.capacity - first);
+                              updateSlots(first, first + untilWrap);
+                              if (untilWrap < length) { updateSlots(0, length - untilWrap); }
+                          });
+}
+
+template<typename Predicate>
+void PF::ParticleEmitter::removeIf(Predicate&& shouldRemove)
+{
+    std::size_t kept = 0;
+    for (std::size_t age = 0; age < m_count; ++age)
+    {
+        const std::size_t slot = getSlot(age);
+        if (shouldRemove(slot)) { continue; }
+        if (kept != age) { m_columns.move(slot, getSlot(kept)); }
+        ++kept;
+    }
+    m_count = kept;
+}
+
+void PF::ParticleEmitter::removeExpired()
+{
+    removeIf([this](std::size_t slot) { return m_columns.size[slot] < m_config.minSize; });
+}
+
+void PF::ParticleEmitter::removeOutside(const SDL_FRect& area)
+{
+    removeIf(
+        [this, &area](std::size_t slot)
+        {
+            const SDL_FRect rect = getBounds(slot);
+            return !SDL_HasRectIntersectionFloat(&rect, &area);
+        });
+}
+
+void PF::ParticleEmitter::capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const
+{
+    const std::size_t first = snapshot.particles.size();
+    for (std::size_t age = 0; age < m_count; ++age)
+    {
+        // Whatever the render thread interpolates to lies within the area swept during the step
+        const std::size_t slot = getSlot(age);
+        const SDL_FPoint previousPosition = {m_columns.previousX[slot], m_columns.previousY[slot]};
+        const SDL_FPoint position = {m_columns.positionX[slot], m_columns.positionY[slot]};
+        const SDL_FRect previous = rectAt(previousPosition, m_columns.size[slot]);
+        const SDL_FRect current = rectAt(position, m_columns.size[slot]);
+        SDL_FRect swept;
+        SDL_GetRectUnionFloat(&previous, &current, &swept);
+        const float rotation = m_columns.angle[slot] * RADIANS_TO_ROTATION;
+        if (!camera.isVisible(swept, rotation)) { continue; }
+
+        snapshot.particles.push_back({.previousPosition = previousPosition,
+                                      .position = position,
+                                      .size = m_columns.size[slot],
+                                      .angle = rotation});
+    }
+
+    if (snapshot.particles.size() == first) { return; }
+    snapshot.particleBatches.push_back({.textureIdx = m_config.textureIdx,
+                                        .srcRect = m_config.srcRect,
+                                        .first = first,
+                                        .count = snapshot.particles.size() - first});
+}
+
+std::size_t PF::ParticleEmitter::getSlot(std::size_t age) const
+{
+    const std::size_t slot = m_head + age;
+    return slot >= m_config.capacity ? slot - m_config.capacity : slot;
+}
+
+SDL_FRect PF::ParticleEmitter::getBounds(std::size_t slot) const
+{
+    return rectAt({m_columns.positionX[slot], m_columns.positionY[slot]}, m_columns.size[slot]);
+}
+
+SDL_FRect PF::ParticleEmitter::rectAt(SDL_FPoint centre, float size) const
+{
+    const float width = m_config.srcRect.w * size;
+    const float height = m_config.srcRect.h * size;
+    return {centre.x - (width / 2), centre.y - (height / 2), width, height};
+}
+
+std::size_t PF::ParticleEmitter::count() const { return m_count; }
+
+std::size_t PF::ParticleEmitter::getCapacity() const { return m_config.capacity; }
+
+PF::PoolOverflowPolicy PF::ParticleEmitter::getOverflowPolicy() const { return m_config.overflowPolicy; }
+
+const PF::EmitterConfig& PF::ParticleEmitter::getConfig() const { return m_config; }
+
+const PF::ParticleColumns& PF::ParticleEmitter::getColumns() const { return m_columns; }
+
+std::size_t PF::ParticleEmitter::getHighWaterMark() const { return m_highWaterMark; }
+
+void PF::ParticleEmitter::resetHighWaterMark() { m_highWaterMark = m_count; }
+
+std::size_t PF::ParticleEmitter::getOverflowCount() const { return m_overflowCount; }
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "Enums.h"
+#include "ParticleKernel.h"
+
+namespace PF
+{
+class Camera;
+class JobSystem;
+struct RenderSnapshot;
+
+/**
+ * @struct EmitterConfig
+ * @brief Everything an emitter's particles share: how they look, how many may live, how they start and move.
+ */
+struct EmitterConfig
+{
+    std::size_t textureIdx = 0;        // Atlas handle every particle is drawn with
+    SDL_FRect srcRect = {0, 0, 0, 0};  // Source rectangle inside the texture, scaled by the particle size
+    std::size_t capacity = 1;          // Maximum number of live particles, greater than zero
+    PF::PoolOverflowPolicy overflowPolicy = PF::PoolOverflowPolicy::RECYCLE_OLDEST;
+    PF::ParticleMotion motion;
+    float speedMultiplier = 1.0F;  // Scales the velocity handed to emit()
+    float speedJitterMin = 1.0F;   // Each axis is scaled again by a random factor in [min, min + range)
+    float speedJitterRange = 0.0F;
+    float sizeFactor = 1.0F;  // Scales the size handed to emit()
+    float minSize = 0.0F;     // Particles shrinking below this size die
+};
+
+/**
+ * @struct ParticleColumns
+ * @brief Structure-of-arrays slots of an emitter's particles, allocated once at the emitter's capacity.
+ */
+struct ParticleColumns
+{
+    std::vector<float> positionX;     /**< World x coordinate of the particle centre. */
+    std::vector<float> positionY;     /**< World y coordinate of the particle centre. */
+    std::vector<float> previousX;     /**< positionX before the last step, to interpolate rendering. */
+    std::vector<float> previousY;     /**< positionY before the last step, to interpolate rendering. */
+    std::vector<float> velocityX;     /**< Horizontal velocity in world units per step. */
+    std::vector<float> velocityY;     /**< Vertical velocity in world units per step. */
+    std::vector<float> size;          /**< Scale applied to the emitter's source rectangle. */
+    std::vector<float> angle;         /**< Animation angle, also used as rotation. */
+    std::vector<Uint64> randomState;  /**< Private state for SDL_randf_r, so particles can update on any thread. */
+
+    void resize(std::size_t capacity);
+
+    /**
+     * @brief Copies every column of slot `from` into slot `to`. Used by stable compaction.
+     */
+    void move(std::size_t from, std::size_t to);
+};
+
+/**
+ * @class ParticleEmitter
+ * @brief Spawns, moves and kills short-lived particles sharing one texture, e.g. the attacks of the players.
+ *
+ * Particles live in a fixed-capacity ring buffer of columns, oldest first from the head. Spawning writes behind the
+ * newest particle and recycling the oldest one only moves the head, so neither touches the heap nor shifts the others.
+ * A step advances all of them at once in ParticleKernel, several particles at a time, and the kill passes compact
+ * the survivors in order. Every particle is drawn with the same texture, so an emitter is drawn in one batch.
+ */
+class ParticleEmitter
+{
+  public:
+    /**
+     * @brief Constructs the emitter and allocates its columns at the configured capacity.
+     */
+    explicit ParticleEmitter(const PF::EmitterConfig& config);
+
+    /**
+     * @brief Changes the pool limit. Live particles beyond the new capacity are retired oldest first.
+     * @param capacity The maximum number of live particles. Must be greater than zero.
+     * @param overflowPolicy What to do when a particle is spawned while the pool is full.
+     * @note This reallocates the columns, so call it at load time rather than mid-game.
+     */
+    void setLimit(std::size_t capacity, PF::PoolOverflowPolicy overflowPolicy);
+
+    /**
+     * @brief Spawns a particle exactly as given.
+     * @param seed The initial state of the particle's random generator.
+     * @return The slot of the new particle, or std::nullopt if the pool is full and drops new particles.
+     */
+    std::optional<std::size_t> spawn(SDL_FPoint position, SDL_FPoint velocity, float size, Uint64 seed);
+
+    /**
+     * @brief Spawns a particle from what its source hands over, scaled and jittered as configured.
+     * @param randomState The source's random generator. The jitter and the particle's seed are drawn from it, so the
+     * particles follow from the source's seed.
+     */
+    void emit(SDL_FPoint position, SDL_FPoint velocity, float size, Uint64& randomState);
+
+    /**
+     * @brief Advances every particle by one step, splitting the ring into chunks across the job system.
+     *
+     * Particles only read and write their own slot, including their own random state, so the result does not depend
+     * on the number of threads or on which thread ran which chunk.
+     */
+    void update(Uint64 stepMs, PF::JobSystem& jobSystem, PF::SimdLevel simdLevel);
+
+    /**
+     * @brief Kills particles that shrank below the minimum size, keeping the order of the survivors.
+     */
+    void removeExpired();
+
+    /**
+     * @brief Kills particles whose sprite no longer overlaps `area`, keeping the order of the survivors.
+     * @param area The world area particles must touch to survive, e.g. the camera view grown by a margin.
+     */
+    void removeOutside(const SDL_FRect& area);
+
+    /**
+     * @brief Appends one batch to `snapshot` with every particle the camera sees at either end of the last step.
+     */
+    void capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const;
+
+    /**
+     * @brief Gets the slot of the particle `age` places after the oldest one, for 0 <= age < count().
+     */
+    [[nodiscard]] std::size_t getSlot(std::size_t age) const;
+
+    /**
+     * @brief Gets the world rectangle of the particle in `slot`, unrotated.
+     */
+    [[nodiscard]] SDL_FRect getBounds(std::size_t slot) const;
+
+    [[nodiscard]] std::size_t count() const;
+    [[nodiscard]] std::size_t getCapacity() const;
+    [[nodiscard]] PF::PoolOverflowPolicy getOverflowPolicy() const;
+    [[nodiscard]] const PF::EmitterConfig& getConfig() const;
+    [[nodiscard]] const PF::ParticleColumns& getColumns() const;
+
+    /**
+     * @brief Gets the highest number of simultaneously live particles since construction or the last reset.
+     */
+    [[nodiscard]] std::size_t getHighWaterMark() const;
+    void resetHighWaterMark();
+
+    /**
+     * @brief Gets how many spawns hit a full pool, either dropped or served by recycling the oldest particle.
+     */
+    [[nodiscard]] std::size_t getOverflowCount() const;
+
+  private:
+    /**
+     * @brief Stable compaction: survivors slide towards the head in order, so draw order matches spawn order.
+     */
+    template<typename Predicate>
+    void removeIf(Predicate&& shouldRemove);
+
+    /**
+     * @brief Gets the world rectangle of a particle centred on `centre`.
+     */
+    [[nodiscard]] SDL_FRect rectAt(SDL_FPoint centre, float size) const;
+
+  private:
+    PF::EmitterConfig m_config;
+    PF::ParticleColumns m_columns;    // Ring buffer of m_config.capacity slots
+    std::size_t m_head = 0;           // Slot of the oldest live particle
+    std::size_t m_count = 0;          // Live particles, in the slots following the head
+    std::size_t m_highWaterMark = 0;  // Peak number of live particles
+    std::size_t m_overflowCount = 0;  // Spawns that found the pool full
+    std::vector<float> m_random;      // Per-tick random samples fed to the kernel, by slot
+};
+}  // namespace PF
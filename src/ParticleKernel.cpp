@@ -0,0 +1,301 @@
+#include <SDL3/SDL.h>
+
+#include <cmath>
+#include <cstddef>
+
+#include "AnimationCurve.h"
+#include "Enums.h"
+#include "GlobalDefinitions.h"
+#include "ParticleKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PF_PARTICLE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define PF_PARTICLE_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Lets GCC and Clang emit wider instructions for a single function without raising the baseline of the whole build
+#if defined(__GNUC__) || defined(__clang__)
+#define PF_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PF_TARGET(isa)
+#endif
+
+// Degree of the sine polynomial shared by every SIMD level
+constexpr int SIN_DEGREE = 9;
+constexpr auto& SIN_COEFFICIENTS = PF::Animation::SinePolynomial<SIN_DEGREE>::COEFFICIENTS;
+constexpr float SIN_C3 = SIN_COEFFICIENTS[0];
+constexpr float SIN_C5 = SIN_COEFFICIENTS[1];
+constexpr float SIN_C7 = SIN_COEFFICIENTS[2];
+constexpr float SIN_C9 = SIN_COEFFICIENTS[3];
+
+using PF::Animation::HALF_PI;
+using PF::Animation::INV_PI;
+using PF::Animation::PI_HI;
+using PF::Animation::PI_LO;
+
+namespace
+{
+float DecelerateScalar(const float velocity, const float deceleration)
+{
+    const bool moving = std::fabs(velocity) > PF::Global::Model::MIN_VELOCITY_THRESHOLD;
+    return moving ? velocity - std::copysign(deceleration, velocity) : 0.0F;
+}
+
+void UpdateScalar(const PF::ParticleKernel::Batch& batch,
+                  const PF::ParticleMotion& motion,
+                  const float angleStep,
+                  std::size_t first)
+{
+    for (std::size_t i = first; i < batch.count; ++i)
+    {
+        const float angle = batch.angle[i] + (angleStep * batch.random[i]);
+        const float sinAngle = PF::Animation::sin<SIN_DEGREE>(angle);
+        const float cosAngle = PF::Animation::sin<SIN_DEGREE>((motion.cosAngleMultiplier * angle) + HALF_PI);
+        const float sinSize = PF::Animation::sin<SIN_DEGREE>(angle * motion.sizeOscillationMultiplier);
+
+        batch.angle[i] = angle;
+        batch.positionX[i] += (batch.velocityX[i] * (1 + sinAngle)) + (motion.wobble * sinAngle);
+        batch.positionY[i] += (batch.velocityY[i] * (1 + cosAngle)) + (motion.wobble * cosAngle);
+        batch.velocityX[i] = DecelerateScalar(batch.velocityX[i], motion.deceleration);
+        batch.velocityY[i] = DecelerateScalar(batch.velocityY[i], motion.deceleration);
+        batch.size[i] = batch.size[i] + (sinSize * motion.sizeOscillation) - (motion.sizeDecay * angle);
+    }
+}
+
+#if PF_PARTICLE_KERNEL_X86
+PF_TARGET("sse2") __m128 SinSse2(const __m128 x)
+{
+    const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_PI)));
+    const __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(PI_HI)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(PI_LO)));
+
+    const __m128 r2 = _mm_mul_ps(r, r);
+    __m128 poly = _mm_set1_ps(SIN_C9);
+    poly = _mm_add_ps(_mm_mul_ps(poly, r2), _mm_set1_ps(SIN_C7));
+    poly = _mm_add_ps(_mm_mul_ps(poly, r2), _mm_set1_ps(SIN_C5));
+    poly = _mm_add_ps(_mm_mul_ps(poly, r2), _mm_set1_ps(SIN_C3));
+    const __m128 sine = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), poly));
+
+    // Odd quadrants flip the sign bit
+    return _mm_xor_ps(sine, _mm_castsi128_ps(_mm_slli_epi32(quadrant, 31)));
+}
+
+PF_TARGET("sse2") __m128 DecelerateSse2(const __m128 velocity, const float deceleration)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0F);
+    const __m128 signedDeceleration = _mm_or_ps(_mm_and_ps(signMask, velocity), _mm_set1_ps(deceleration));
+    const __m128 moving =
+        _mm_cmpgt_ps(_mm_andnot_ps(signMask, velocity), _mm_set1_ps(PF::Global::Model::MIN_VELOCITY_THRESHOLD));
+    return _mm_and_ps(moving, _mm_sub_ps(velocity, signedDeceleration));
+}
+
+PF_TARGET("sse2") std::size_t UpdateSse2(const PF::ParticleKernel::Batch& batch,
+                                         const PF::ParticleMotion& motion,
+                                         const float angleStep)
+{
+    constexpr std::size_t LANES = 4;
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 offset = _mm_set1_ps(motion.wobble);
+
+    std::size_t i = 0;
+    for (; i + LANES <= batch.count; i += LANES)
+    {
+        const __m128 randomStep = _mm_mul_ps(_mm_set1_ps(angleStep), _mm_loadu_ps(batch.random + i));
+        const __m128 angle = _mm_add_ps(_mm_loadu_ps(batch.angle + i), randomStep);
+        const __m128 sinAngle = SinSse2(angle);
+        const __m128 cosAngle =
+            SinSse2(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(motion.cosAngleMultiplier), angle), _mm_set1_ps(HALF_PI)));
+        const __m128 sinSize = SinSse2(_mm_mul_ps(angle, _mm_set1_ps(motion.sizeOscillationMultiplier)));
+
+        const __m128 velocityX = _mm_loadu_ps(batch.velocityX + i);
+        const __m128 velocityY = _mm_loadu_ps(batch.velocityY + i);
+        const __m128 deltaX =
+            _mm_add_ps(_mm_mul_ps(velocityX, _mm_add_ps(one, sinAngle)), _mm_mul_ps(offset, sinAngle));
+        const __m128 deltaY =
+            _mm_add_ps(_mm_mul_ps(velocityY, _mm_add_ps(one, cosAngle)), _mm_mul_ps(offset, cosAngle));
+        const __m128 oscillation = _mm_mul_ps(sinSize, _mm_set1_ps(motion.sizeOscillation));
+        const __m128 size = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(batch.size + i), oscillation),
+                                       _mm_mul_ps(_mm_set1_ps(motion.sizeDecay), angle));
+
+        _mm_storeu_ps(batch.angle + i, angle);
+        _mm_storeu_ps(batch.positionX + i, _mm_add_ps(_mm_loadu_ps(batch.positionX + i), deltaX));
+        _mm_storeu_ps(batch.positionY + i, _mm_add_ps(_mm_loadu_ps(batch.positionY + i), deltaY));
+        _mm_storeu_ps(batch.velocityX + i, DecelerateSse2(velocityX, motion.deceleration));
+        _mm_storeu_ps(batch.velocityY + i, DecelerateSse2(velocityY, motion.deceleration));
+        _mm_storeu_ps(batch.size + i, size);
+    }
+    return i;
+}
+
+PF_TARGET("avx2") __m256 SinAvx2(const __m256 x)
+{
+    const __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(INV_PI)));
+    const __m256 q = _mm256_cvtepi32_ps(quadrant);
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(PI_HI)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(PI_LO)));
+
+    // Plain multiply/add rather than FMA, so every SIMD level rounds the same way
+    const __m256 r2 = _mm256_mul_ps(r, r);
+    __m256 poly = _mm256_set1_ps(SIN_C9);
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, r2), _mm256_set1_ps(SIN_C7));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, r2), _mm256_set1_ps(SIN_C5));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, r2), _mm256_set1_ps(SIN_C3));
+    const __m256 sine = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), poly));
+
+    // Odd quadrants flip the sign bit
+    return _mm256_xor_ps(sine, _mm256_castsi256_ps(_mm256_slli_epi32(quadrant, 31)));
+}
+
+PF_TARGET("avx2") __m256 DecelerateAvx2(const __m256 velocity, const float deceleration)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0F);
+    const __m256 signedDeceleration = _mm256_or_ps(_mm256_and_ps(signMask, velocity), _mm256_set1_ps(deceleration));
+    const __m256 moving = _mm256_cmp_ps(
+        _mm256_andnot_ps(signMask, velocity), _mm256_set1_ps(PF::Global::Model::MIN_VELOCITY_THRESHOLD), _CMP_GT_OQ);
+    return _mm256_and_ps(moving, _mm256_sub_ps(velocity, signedDeceleration));
+}
+
+PF_TARGET("avx2") std::size_t UpdateAvx2(const PF::ParticleKernel::Batch& batch,
+                                         const PF::ParticleMotion& motion,
+                                         const float angleStep)
+{
+    constexpr std::size_t LANES = 8;
+    const __m256 one = _mm256_set1_ps(1.0F);
+    const __m256 offset = _mm256_set1_ps(motion.wobble);
+
+    std::size_t i = 0;
+    for (; i + LANES <= batch.count; i += LANES)
+    {
+        const __m256 angle = _mm256_add_ps(_mm256_loadu_ps(batch.angle + i),
+                                           _mm256_mul_ps(_mm256_set1_ps(angleStep), _mm256_loadu_ps(batch.random + i)));
+        const __m256 sinAngle = SinAvx2(angle);
+        const __m256 cosAngle = SinAvx2(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(motion.cosAngleMultiplier), angle), _mm256_set1_ps(HALF_PI)));
+        const __m256 sinSize = SinAvx2(_mm256_mul_ps(angle, _mm256_set1_ps(motion.sizeOscillationMultiplier)));
+
+        const __m256 velocityX = _mm256_loadu_ps(batch.velocityX + i);
+        const __m256 velocityY = _mm256_loadu_ps(batch.velocityY + i);
+        const __m256 deltaX =
+            _mm256_add_ps(_mm256_mul_ps(velocityX, _mm256_add_ps(one, sinAngle)), _mm256_mul_ps(offset, sinAngle));
+        const __m256 deltaY =
+            _mm256_add_ps(_mm256_mul_ps(velocityY, _mm256_add_ps(one, cosAngle)), _mm256_mul_ps(offset, cosAngle));
+        const __m256 oscillation = _mm256_mul_ps(sinSize, _mm256_set1_ps(motion.sizeOscillation));
+        const __m256 size = _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(batch.size + i), oscillation),
+                                          _mm256_mul_ps(_mm256_set1_ps(motion.sizeDecay), angle));
+
+        _mm256_storeu_ps(batch.angle + i, angle);
+        _mm256_storeu_ps(batch.positionX + i, _mm256_add_ps(_mm256_loadu_ps(batch.positionX + i), deltaX));
+        _mm256_storeu_ps(batch.positionY + i, _mm256_add_ps(_mm256_loadu_ps(batch.positionY + i), deltaY));
+        _mm256_storeu_ps(batch.velocityX + i, DecelerateAvx2(velocityX, motion.deceleration));
+        _mm256_storeu_ps(batch.velocityY + i, DecelerateAvx2(velocityY, motion.deceleration));
+        _mm256_storeu_ps(batch.size + i, size);
+    }
+    return i;
+}
+#endif
+
+#if PF_PARTICLE_KERNEL_NEON
+float32x4_t SinNeon(const float32x4_t x)
+{
+    const int32x4_t quadrant = vcvtnq_s32_f32(vmulq_n_f32(x, INV_PI));
+    const float32x4_t q = vcvtq_f32_s32(quadrant);
+    float32x4_t r = vsubq_f32(x, vmulq_n_f32(q, PI_HI));
+    r = vsubq_f32(r, vmulq_n_f32(q, PI_LO));
+
+    // Plain multiply/add rather than fused multiply-add, so every SIMD level rounds the same way
+    const float32x4_t r2 = vmulq_f32(r, r);
+    float32x4_t poly = vdupq_n_f32(SIN_C9);
+    poly = vaddq_f32(vmulq_f32(poly, r2), vdupq_n_f32(SIN_C7));
+    poly = vaddq_f32(vmulq_f32(poly, r2), vdupq_n_f32(SIN_C5));
+    poly = vaddq_f32(vmulq_f32(poly, r2), vdupq_n_f32(SIN_C3));
+    const float32x4_t sine = vaddq_f32(r, vmulq_f32(vmulq_f32(r, r2), poly));
+
+    // Odd quadrants flip the sign bit
+    const uint32x4_t sign = vshlq_n_u32(vreinterpretq_u32_s32(quadrant), 31);
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sine), sign));
+}
+
+float32x4_t DecelerateNeon(const float32x4_t velocity, const float deceleration)
+{
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000U);
+    const float32x4_t signedDeceleration = vbslq_f32(signMask, velocity, vdupq_n_f32(deceleration));
+    const uint32x4_t moving = vcgtq_f32(vabsq_f32(velocity), vdupq_n_f32(PF::Global::Model::MIN_VELOCITY_THRESHOLD));
+    return vreinterpretq_f32_u32(vandq_u32(moving, vreinterpretq_u32_f32(vsubq_f32(velocity, signedDeceleration))));
+}
+
+std::size_t UpdateNeon(const PF::ParticleKernel::Batch& batch, const PF::ParticleMotion& motion, const float angleStep)
+{
+    constexpr std::size_t LANES = 4;
+    const float32x4_t one = vdupq_n_f32(1.0F);
+
+    std::size_t i = 0;
+    for (; i + LANES <= batch.count; i += LANES)
+    {
+        const float32x4_t randomStep = vmulq_n_f32(vld1q_f32(batch.random + i), angleStep);
+        const float32x4_t angle = vaddq_f32(vld1q_f32(batch.angle + i), randomStep);
+        const float32x4_t sinAngle = SinNeon(angle);
+        const float32x4_t cosAngle =
+            SinNeon(vaddq_f32(vmulq_n_f32(angle, motion.cosAngleMultiplier), vdupq_n_f32(HALF_PI)));
+        const float32x4_t sinSize = SinNeon(vmulq_n_f32(angle, motion.sizeOscillationMultiplier));
+
+        const float32x4_t velocityX = vld1q_f32(batch.velocityX + i);
+        const float32x4_t velocityY = vld1q_f32(batch.velocityY + i);
+        const float32x4_t deltaX =
+            vaddq_f32(vmulq_f32(velocityX, vaddq_f32(one, sinAngle)), vmulq_n_f32(sinAngle, motion.wobble));
+        const float32x4_t deltaY =
+            vaddq_f32(vmulq_f32(velocityY, vaddq_f32(one, cosAngle)), vmulq_n_f32(cosAngle, motion.wobble));
+        const float32x4_t oscillation = vmulq_n_f32(sinSize, motion.sizeOscillation);
+        const float32x4_t size =
+            vsubq_f32(vaddq_f32(vld1q_f32(batch.size + i), oscillation), vmulq_n_f32(angle, motion.sizeDecay));
+
+        vst1q_f32(batch.angle + i, angle);
+        vst1q_f32(batch.positionX + i, vaddq_f32(vld1q_f32(batch.positionX + i), deltaX));
+        vst1q_f32(batch.positionY + i, vaddq_f32(vld1q_f32(batch.positionY + i), deltaY));
+        vst1q_f32(batch.velocityX + i, DecelerateNeon(velocityX, motion.deceleration));
+        vst1q_f32(batch.velocityY + i, DecelerateNeon(velocityY, motion.deceleration));
+        vst1q_f32(batch.size + i, size);
+    }
+    return i;
+}
+#endif
+}  // namespace
+
+PF::SimdLevel PF::ParticleKernel::detectSimdLevel()
+{
+#if PF_PARTICLE_KERNEL_X86
+    if (SDL_HasAVX2()) { return PF::SimdLevel::AVX2; }
+    if (SDL_HasSSE2()) { return PF::SimdLevel::SSE2; }
+#elif PF_PARTICLE_KERNEL_NEON
+    if (SDL_HasNEON()) { return PF::SimdLevel::NEON; }
+#endif
+    return PF::SimdLevel::SCALAR;
+}
+
+void PF::ParticleKernel::update(const Batch& batch,
+                                const PF::ParticleMotion& motion,
+                                float stepMs,
+                                PF::SimdLevel simdLevel)
+{
+    const float angleStep = stepMs * motion.angleIncrement;
+
+    // The wide paths stop at the last full vector, and the scalar loop finishes the remainder
+    std::size_t processed = 0;
+    switch (simdLevel)
+    {
+#if PF_PARTICLE_KERNEL_X86
+        case PF::SimdLevel::AVX2: processed = UpdateAvx2(batch, motion, angleStep); break;
+        case PF::SimdLevel::SSE2: processed = UpdateSse2(batch, motion, angleStep); break;
+#endif
+#if PF_PARTICLE_KERNEL_NEON
+        case PF::SimdLevel::NEON: processed = UpdateNeon(batch, motion, angleStep); break;
+#endif
+        default: break;
+    }
+    UpdateScalar(batch, motion, angleStep, processed);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Enums.h"
+
+namespace PF
+{
+/**
+ * @struct ParticleMotion
+ * @brief How the particles of an emitter drift, wobble and shrink, step after step.
+ *
+ * Every step, a particle's angle grows by a random fraction of `angleIncrement` per millisecond. Its position moves
+ * along its velocity, stretched and offset by the sine of that angle (the cosine, at `cosAngleMultiplier` times the
+ * angle, vertically). Its velocity loses `deceleration` until it stops, and its size oscillates with the angle while
+ * shrinking in proportion to it.
+ */
+struct ParticleMotion
+{
+    float angleIncrement = 0.0F;             // Largest angle gained per millisecond
+    float deceleration = 0.0F;               // Speed lost per step, on each axis
+    float cosAngleMultiplier = 1.0F;         // Frequency of the vertical wobble, relative to the horizontal one
+    float wobble = 0.0F;                     // Offset added along the wobble, in world units per step
+    float sizeOscillation = 0.0F;            // Amplitude of the size oscillation, per step
+    float sizeOscillationMultiplier = 1.0F;  // Frequency of the size oscillation, relative to the angle
+    float sizeDecay = 0.0F;                  // Size lost per step, per radian of angle
+};
+}  // namespace PF
+
+namespace PF::ParticleKernel
+{
+// Accuracy of every SIMD level against the per-object libm code, checked by perfectform_bench before it times anything
+constexpr float TRIG_ANGLE_RANGE = 512.0F;   // |argument| of sin/cos below which TRIG_TOLERANCE holds, in radians
+constexpr float TRIG_TOLERANCE = 1e-5F;      // Largest difference between the kernel's sin/cos and sinf/cosf
+constexpr float POSITION_TOLERANCE = 1e-4F;  // Largest difference from the reference position after a step, in px
+constexpr float SIZE_TOLERANCE = 1e-7F;      // Largest difference from the reference size after a step
+
+/**
+ * @struct Batch
+ * @brief Column pointers for a contiguous range of particles advanced together by the kernel.
+ *
+ * Every pointer must address at least `count` floats. `random` holds one uniform [0, 1) sample per particle, drawn
+ * before the kernel runs so every SIMD width consumes the same random sequence.
+ */
+struct Batch
+{
+    float* positionX = nullptr;
+    float* positionY = nullptr;
+    float* velocityX = nullptr;
+    float* velocityY = nullptr;
+    float* size = nullptr;
+    float* angle = nullptr;
+    const float* random = nullptr;
+    std::size_t count = 0;
+};
+
+/**
+ * @brief Picks the widest instruction set supported by both the build and the running CPU.
+ */
+[[nodiscard]] PF::SimdLevel detectSimdLevel();
+
+/**
+ * @brief Advances every particle of the batch by one simulation step.
+ *
+ * The kernel replaces libm sinf/cosf with the range-reduced degree 9 polynomial of AnimationCurve.h, and the
+ * deceleration branches with sign masks. Compared with the per-object libm code, sin and cos stay within
+ * TRIG_TOLERANCE of sinf/cosf while their argument, the angle times its multiplier, is below TRIG_ANGLE_RANGE: an
+ * attack's angle grows to a few tens of radians over its whole lifetime. Past that range, rounding the argument costs
+ * more than the polynomial does. Within it, a single step lands within POSITION_TOLERANCE of the reference position and
+ * within SIZE_TOLERANCE of the reference size. All SIMD levels, including the scalar fallback, share the same
+ * polynomial, so they agree with each other to the last few ulps.
+ *
+ * @param batch The particle columns to advance.
+ * @param motion The motion of the emitter the particles belong to.
+ * @param stepMs The simulation step in milliseconds.
+ * @param simdLevel The instruction set to use. Levels not compiled into this build fall back to SCALAR.
+ */
+void update(const Batch& batch, const PF::ParticleMotion& motion, float stepMs, PF::SimdLevel simdLevel);
+}  // namespace PF::ParticleKernel
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+#include "ParticleKernel.h"
+#include "ParticleSystem.h"
+#include "RenderSnapshot.h"
+
+namespace
+{
+bool OwnerLess(const PF::EntityRef& left, const PF::EntityRef& right)
+{
+    return std::tie(left.kind, left.index) < std::tie(right.kind, right.index);
+}
+}  // namespace
+
+PF::ParticleSystem::ParticleSystem(): m_simdLevel(PF::ParticleKernel::detectSimdLevel()) {}
+
+std::size_t PF::ParticleSystem::addEmitter(const PF::EmitterConfig& config)
+{
+    m_emitters.emplace_back(config);
+    return m_emitters.size() - 1;
+}
+
+void PF::ParticleSystem::attach(PF::EntityRef owner, std::size_t emitter)
+{
+    assert(emitter < m_emitters.size() && "Attaching an emitter that does not exist.");
+
+    // After the owner's other emitters, so they keep emitting in attachment order
+    const auto position = std::upper_bound(m_attachments.begin(),
+                                           m_attachments.end(),
+                                           owner,
+                                           [](const PF::EntityRef& value, const auto& attachment)
+                                           { return OwnerLess(value, attachment.first); });
+    m_attachments.insert(position, {owner, emitter});
+}
+
+void PF::ParticleSystem::emitFrom(
+    PF::EntityRef owner, SDL_FPoint position, SDL_FPoint velocity, float size, Uint64& randomState)
+{
+    auto attachment = std::lower_bound(m_attachments.begin(),
+                                       m_attachments.end(),
+                                       owner,
+                                       [](const auto& attachment, const PF::EntityRef& value)
+                                       { return OwnerLess(attachment.first, value); });
+    for (; attachment != m_attachments.end() && !OwnerLess(owner, attachment->first); ++attachment)
+    {
+        m_emitters[attachment->second].emit(position, velocity, size, randomState);
+    }
+}
+
+void PF::ParticleSystem::update(Uint64 stepMs, PF::JobSystem& jobSystem)
+{
+    for (PF::ParticleEmitter& emitter : m_emitters) { emitter.update(stepMs, jobSystem, m_simdLevel); }
+}
+
+void PF::ParticleSystem::removeExpired()
+{
+    for (PF::ParticleEmitter& emitter : m_emitters) { emitter.removeExpired(); }
+}
+
+void PF::ParticleSystem::removeOutside(const SDL_FRect& area)
+{
+    for (PF::ParticleEmitter& emitter : m_emitters) { emitter.removeOutside(area); }
+}
+
+void PF::ParticleSystem::capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const
+{
+    for (const PF::ParticleEmitter& emitter : m_emitters) { emitter.capture(snapshot, camera); }
+    snapshot.particleCount = count();
+    snapshot.particleHighWaterMark = getHighWaterMark();
+}
+
+PF::ParticleEmitter& PF::ParticleSystem::getEmitter(std::size_t emitter)
+{
+    if (emitter >= m_emitters.size()) { throw std::out_of_range("Particle emitter index out of range"); }
+    return m_emitters[emitter];
+}
+
+const PF::ParticleEmitter& PF::ParticleSystem::getEmitter(std::size_t emitter) const
+{
+    if (emitter >= m_emitters.size()) { throw std::out_of_range("Particle emitter index out of range"); }
+    return m_emitters[emitter];
+}
+
+std::size_t PF::ParticleSystem::getEmitterCount() const { return m_emitters.size(); }
+
+std::size_t PF::ParticleSystem::count() const
+{
+    std::size_t particles = 0;
+    for (const PF::ParticleEmitter& emitter : m_emitters) { particles += emitter.count(); }
+    return particles;
+}
+
+std::size_t PF::ParticleSystem::getHighWaterMark() const
+{
+    std::size_t highWaterMark = 0;
+    for (const PF::ParticleEmitter& emitter : m_emitters) { highWaterMark += emitter.getHighWaterMark(); }
+    return highWaterMark;
+}
+
+PF::SimdLevel PF::ParticleSystem::getSimdLevel() const { return m_simdLevel; }
+
+void PF::ParticleSystem::setSimdLevel(PF::SimdLevel simdLevel) { m_simdLevel = simdLevel; }
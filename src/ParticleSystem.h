@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Enums.h"
+#include "ParticleEmitter.h"
+#include "SpatialHash.h"
+
+namespace PF
+{
+class Camera;
+class JobSystem;
+struct RenderSnapshot;
+
+/**
+ * @class ParticleSystem
+ * @brief Owns every particle emitter, and the entities they are attached to.
+ *
+ * Entities do not hold particles: they hand what a particle starts from to the emitters attached to them, e.g. a
+ * player firing an attack. Several entities may share an emitter, so particles drawn alike stay in one pool and one
+ * batch whatever the number of sources. Emitters are stepped, culled and drawn in the order they were added.
+ */
+class ParticleSystem
+{
+  public:
+    ParticleSystem();
+
+    /**
+     * @brief Adds an emitter, which only spawns particles once attached to an entity or told to directly.
+     * @return The index of the emitter.
+     */
+    std::size_t addEmitter(const PF::EmitterConfig& config);
+
+    /**
+     * @brief Lets `owner` emit into an emitter. An entity may have several emitters, and an emitter several owners.
+     * @param owner The entity, which must keep its index for as long as it emits.
+     * @param emitter An index returned by addEmitter().
+     */
+    void attach(PF::EntityRef owner, std::size_t emitter);
+
+    /**
+     * @brief Emits a particle into every emitter attached to `owner`, in the order they were attached.
+     * @param randomState The owner's random generator, see ParticleEmitter::emit().
+     */
+    void emitFrom(PF::EntityRef owner, SDL_FPoint position, SDL_FPoint velocity, float size, Uint64& randomState);
+
+    /**
+     * @brief Advances the particles of every emitter by one step, see ParticleEmitter::update().
+     */
+    void update(Uint64 stepMs, PF::JobSystem& jobSystem);
+
+    /**
+     * @brief Kills the particles of every emitter that shrank below their minimum size.
+     */
+    void removeExpired();
+
+    /**
+     * @brief Kills the particles of every emitter whose sprite no longer overlaps `area`.
+     */
+    void removeOutside(const SDL_FRect& area);
+
+    /**
+     * @brief Appends one batch per emitter to `snapshot`, with the particles the camera sees, and their count.
+     */
+    void capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const;
+
+    [[nodiscard]] PF::ParticleEmitter& getEmitter(std::size_t emitter);
+    [[nodiscard]] const PF::ParticleEmitter& getEmitter(std::size_t emitter) const;
+    [[nodiscard]] std::size_t getEmitterCount() const;
+
+    /**
+     * @brief Gets the number of live particles, summed over every emitter.
+     */
+    [[nodiscard]] std::size_t count() const;
+
+    /**
+     * @brief Gets the sum of the emitters' high-water marks.
+     */
+    [[nodiscard]] std::size_t getHighWaterMark() const;
+
+    /**
+     * @brief Gets the instruction set used by the particle kernel. Defaults to the widest one the CPU supports.
+     */
+    [[nodiscard]] PF::SimdLevel getSimdLevel() const;
+
+    /**
+     * @brief Forces the instruction set used by the particle kernel, e.g. to compare widths in benchmarks.
+     */
+    void setSimdLevel(PF::SimdLevel simdLevel);
+
+  private:
+    std::vector<PF::ParticleEmitter> m_emitters;
+    std::vector<std::pair<PF::EntityRef, std::size_t>> m_attachments;  // Owner and emitter, sorted by owner
+    PF::SimdLevel m_simdLevel;                                         // Instruction set used by the particle kernel
+};
+}  // namespace PF
@@ -1,101 +1,171 @@
-#include <cmath>
+#include <array>
 #include <cstddef>
-#include <memory>
+#include <cstdint>
 
+#include "AnimationCurve.h"
+#include "Camera.h"
 #include "Enums.h"
 #include "Exceptions.h"
-#include "Object.h"
+#include "GlobalDefinitions.h"
+#include "ParticleSystem.h"
 #include "Player.h"
-#include "TextureManager.h"
+#include "RenderSnapshot.h"
 
 constexpr float ANGLE_INCREMENT = 0.0007F;
-constexpr float ATTACK_ANGLE_INCREMENT = 0.005F;
 constexpr float SCALE_FACTOR = 0.05F;
 constexpr float SCALE_ANGLE_MULTIPLIER = 7.0F;
+constexpr std::size_t SCALE_TABLE_SIZE = 256;  // Samples of the pulse sine, its error is far below a pixel
 constexpr float VELOCITY = 2.0F;
-constexpr float MIN_VELOCITY_THRESHOLD = 0.001F;
-constexpr float ATTACK_SIZE_FACTOR = 0.3333F;
-constexpr float ATTACK_VELOCITY_MULTIPLIER = 2.0F;
-constexpr float ATTACK_DECELERATION = 0.025F;
-constexpr float COS_ANGLE_MULTIPLIER = 1.33F;
-constexpr float POSITION_OFFSET = 0.5F;
-constexpr float ATTACK_SIZE_OSCILLATION = 0.005F;
-constexpr float ATTACK_SIZE_DECAY = 0.00005F;
-constexpr float MIN_ATTACK_SIZE = 0.02F;
 constexpr float DIAGONAL_FACTOR = 0.7071F;  // 1/sqrt(2) for diagonal movement
 constexpr Uint64 ATTACK_COOLDOWN_MS = 100;  // Time between attacks in milliseconds
 
-PF::Player::Player(std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size)
-    : Object(textureIdx, srcRect, position, size)
+namespace
 {
+struct IntentionPair
+{
+    PF::PlayerIntention start;
+    PF::PlayerIntention stop;
+};
+
+constexpr std::array<IntentionPair, PF::PlayerStore::INTENTION_PAIR_COUNT> INTENTION_PAIRS{{
+    {PF::PlayerIntention::MOVE_UP, PF::PlayerIntention::MOVE_STOP_UP},
+    {PF::PlayerIntention::MOVE_DOWN, PF::PlayerIntention::MOVE_STOP_DOWN},
+    {PF::PlayerIntention::MOVE_LEFT, PF::PlayerIntention::MOVE_STOP_LEFT},
+    {PF::PlayerIntention::MOVE_RIGHT, PF::PlayerIntention::MOVE_STOP_RIGHT},
+    {PF::PlayerIntention::ATTACK, PF::PlayerIntention::ATTACK_STOP},
+}};
+}  // namespace
+
+std::size_t PF::PlayerStore::add(
+    std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size, Uint64 seed)
+{
+    const auto index = m_columns.push(textureIdx, srcRect, position, size, seed);
+    m_playerClock.push_back(0);
+    m_movementState.push_back(State::IDLE);
+    m_actionState.push_back(State::IDLE);
+    m_needToSpawnAttack.push_back(0);
+    m_lastAttackTime.push_back(0);
+    m_lastVelocity.push_back({0.0F, 0.0F});
+    return index;
 }
 
-void PF::Player::update(Uint64 stepMs)
+void PF::PlayerStore::update(Uint64 stepMs, PF::JobSystem& /*jobSystem*/)
 {
-    m_playerClock += stepMs;  // Update player clock
+    const std::size_t count = m_columns.count();
+    m_columns.storePreviousPositions(0, count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_playerClock[i] += stepMs;  // Update player clock
+
+        updateVelocity(i);
+
+        switch (m_actionState[i])
+        {
+            case State::IDLE:
+            {
+                m_needToSpawnAttack[i] = 0;  // Reset the flag when not attacking
+                m_lastAttackTime[i] = 0;     // Reset the last attack time
+                break;
+            }
+            case State::ATTACKING:
+            {
+                m_needToSpawnAttack[i] = m_playerClock[i] - m_lastAttackTime[i] >= ATTACK_COOLDOWN_MS ? 1 : 0;
+                break;
+            }
+            default:
+            {
+                throw PF::Exception("Invalid player action state");
+            }
+        }
+
+        m_columns.angle[i] += static_cast<float>(stepMs) * ANGLE_INCREMENT;
+        m_columns.positionX[i] += m_columns.velocityX[i];  // Update position based on velocity
+        m_columns.positionY[i] += m_columns.velocityY[i];  // Update position based on velocity
+        const float pulse = PF::Animation::sinTable<SCALE_TABLE_SIZE>(m_columns.angle[i] * SCALE_ANGLE_MULTIPLIER);
+        m_columns.size[i] = 1.0F + (pulse * SCALE_FACTOR);  // Scale between 0.95 and 1.05
+    }
+
+    // The taps of this step have now moved or attacked once, so their releases can land
+    for (std::size_t pair = 0; pair < INTENTION_PAIR_COUNT; ++pair)
+    {
+        if (m_stopDeferred[pair] != 0)
+        {
+            for (std::size_t i = 0; i < count; ++i) { handleEvent(i, INTENTION_PAIRS[pair].stop); }
+        }
+        m_startedThisStep[pair] = 0;
+        m_stopDeferred[pair] = 0;
+    }
+}
+
+void PF::PlayerStore::removeExpired() {}
+
+void PF::PlayerStore::updateVelocity(std::size_t index)
+{
+    float& velocityX = m_columns.velocityX[index];
+    float& velocityY = m_columns.velocityY[index];
 
     // Update velocity based on the current state
-    switch (m_movementState)
+    switch (m_movementState[index])
     {
         case State::IDLE:
         {
-            const float velocitySum = (m_velocity.x * m_velocity.x) + (m_velocity.y * m_velocity.y);
+            const float velocitySum = (velocityX * velocityX) + (velocityY * velocityY);
             if (velocitySum >= VELOCITY)
             {
                 // Store the last velocity before stopping
-                m_lastVelocity = m_velocity;
+                m_lastVelocity[index] = {velocityX, velocityY};
             }
 
-            m_velocity.x = 0.0F;
-            m_velocity.y = 0.0F;
+            velocityX = 0.0F;
+            velocityY = 0.0F;
             break;
         }
         case State::MOVING_UP:
         {
-            m_velocity.x = 0.0F;
-            m_velocity.y = -VELOCITY;
+            velocityX = 0.0F;
+            velocityY = -VELOCITY;
             break;
         }
         case State::MOVING_DOWN:
         {
-            m_velocity.x = 0.0F;
-            m_velocity.y = VELOCITY;
+            velocityX = 0.0F;
+            velocityY = VELOCITY;
             break;
         }
         case State::MOVING_LEFT:
         {
-            m_velocity.x = -VELOCITY;
-            m_velocity.y = 0.0F;
+            velocityX = -VELOCITY;
+            velocityY = 0.0F;
             break;
         }
         case State::MOVING_RIGHT:
         {
-            m_velocity.x = VELOCITY;
-            m_velocity.y = 0.0F;
+            velocityX = VELOCITY;
+            velocityY = 0.0F;
             break;
         }
         case State::MOVING_UP_LEFT:
         {
-            m_velocity.x = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
-            m_velocity.y = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityX = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityY = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
             break;
         }
         case State::MOVING_UP_RIGHT:
         {
-            m_velocity.x = VELOCITY * DIAGONAL_FACTOR;   // Diagonal movement
-            m_velocity.y = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityX = VELOCITY * DIAGONAL_FACTOR;   // Diagonal movement
+            velocityY = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
             break;
         }
         case State::MOVING_DOWN_LEFT:
         {
-            m_velocity.x = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
-            m_velocity.y = VELOCITY * DIAGONAL_FACTOR;   // Diagonal movement
+            velocityX = -VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityY = VELOCITY * DIAGONAL_FACTOR;   // Diagonal movement
             break;
         }
         case State::MOVING_DOWN_RIGHT:
         {
-            m_velocity.x = VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
-            m_velocity.y = VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityX = VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
+            velocityY = VELOCITY * DIAGONAL_FACTOR;  // Diagonal movement
             break;
         }
         default:
@@ -103,150 +173,157 @@ void PF::Player::update(Uint64 stepMs)
             throw PF::Exception("Invalid player movement state");
         }
     }
+}
 
-    switch (m_actionState)
-    {
-        case State::IDLE:
-        {
-            m_needToSpawnAttack = false;  // Reset the flag when not attacking
-            m_lastAttackTime = 0;         // Reset the last attack time
-            break;
-        }
-        case State::ATTACKING:
-        {
-            m_needToSpawnAttack = m_playerClock - m_lastAttackTime >= ATTACK_COOLDOWN_MS;
-            break;
-        }
-        default:
-        {
-            throw PF::Exception("Invalid player action state");
-        }
-    }
-
-    m_angle += static_cast<float>(stepMs) * ANGLE_INCREMENT;
-    m_position.x += m_velocity.x;                                             // Update position based on velocity
-    m_position.y += m_velocity.y;                                             // Update position based on velocity
-    m_size = 1.0F + (sinf(m_angle * SCALE_ANGLE_MULTIPLIER) * SCALE_FACTOR);  // Scale between 0.95 and 1.05
+bool PF::PlayerStore::isMovingUp(std::size_t index) const
+{
+    const State state = m_movementState[index];
+    return state == State::MOVING_UP || state == State::MOVING_UP_LEFT || state == State::MOVING_UP_RIGHT;
 }
 
-bool PF::Player::isMovingUp() const
+bool PF::PlayerStore::isMovingDown(std::size_t index) const
 {
-    return m_movementState == State::MOVING_UP || m_movementState == State::MOVING_UP_LEFT ||
-           m_movementState == State::MOVING_UP_RIGHT;
+    const State state = m_movementState[index];
+    return state == State::MOVING_DOWN || state == State::MOVING_DOWN_LEFT || state == State::MOVING_DOWN_RIGHT;
 }
 
-bool PF::Player::isMovingDown() const
+bool PF::PlayerStore::isMovingLeft(std::size_t index) const
 {
-    return m_movementState == State::MOVING_DOWN || m_movementState == State::MOVING_DOWN_LEFT ||
-           m_movementState == State::MOVING_DOWN_RIGHT;
+    const State state = m_movementState[index];
+    return state == State::MOVING_LEFT || state == State::MOVING_UP_LEFT || state == State::MOVING_DOWN_LEFT;
 }
 
-bool PF::Player::isMovingLeft() const
+bool PF::PlayerStore::isMovingRight(std::size_t index) const
 {
-    return m_movementState == State::MOVING_LEFT || m_movementState == State::MOVING_UP_LEFT ||
-           m_movementState == State::MOVING_DOWN_LEFT;
+    const State state = m_movementState[index];
+    return state == State::MOVING_RIGHT || state == State::MOVING_UP_RIGHT || state == State::MOVING_DOWN_RIGHT;
 }
 
-bool PF::Player::isMovingRight() const
+void PF::PlayerStore::handleAttackIntention(std::size_t index, const bool stop)
 {
-    return m_movementState == State::MOVING_RIGHT || m_movementState == State::MOVING_UP_RIGHT ||
-           m_movementState == State::MOVING_DOWN_RIGHT;
+    m_actionState[index] = stop ? State::IDLE : State::ATTACKING;
 }
 
-void PF::Player::handleAttackIntention(const bool stop) { m_actionState = stop ? State::IDLE : State::ATTACKING; }
+void PF::PlayerStore::handleMoveUp(std::size_t index, const bool stop)
+{
+    const bool left = isMovingLeft(index);
+    const bool right = isMovingRight(index);
+
+    State& state = m_movementState[index];
+    if (left && !right) { state = stop ? State::MOVING_LEFT : State::MOVING_UP_LEFT; }
+    else if (right && !left) { state = stop ? State::MOVING_RIGHT : State::MOVING_UP_RIGHT; }
+    else { state = stop ? State::IDLE : State::MOVING_UP; }
+}
 
-void PF::Player::handleMoveUp(const bool stop)
+void PF::PlayerStore::handleMoveDown(std::size_t index, const bool stop)
 {
-    const bool left = isMovingLeft();
-    const bool right = isMovingRight();
+    const bool left = isMovingLeft(index);
+    const bool right = isMovingRight(index);
 
-    if (left && !right) { m_movementState = stop ? State::MOVING_LEFT : State::MOVING_UP_LEFT; }
-    else if (right && !left) { m_movementState = stop ? State::MOVING_RIGHT : State::MOVING_UP_RIGHT; }
-    else { m_movementState = stop ? State::IDLE : State::MOVING_UP; }
+    State& state = m_movementState[index];
+    if (left && !right) { state = stop ? State::MOVING_LEFT : State::MOVING_DOWN_LEFT; }
+    else if (right && !left) { state = stop ? State::MOVING_RIGHT : State::MOVING_DOWN_RIGHT; }
+    else { state = stop ? State::IDLE : State::MOVING_DOWN; }
 }
 
-void PF::Player::handleMoveDown(const bool stop)
+void PF::PlayerStore::handleMoveLeft(std::size_t index, const bool stop)
 {
-    const bool left = isMovingLeft();
-    const bool right = isMovingRight();
+    const bool up = isMovingUp(index);
+    const bool down = isMovingDown(index);
 
-    if (left && !right) { m_movementState = stop ? State::MOVING_LEFT : State::MOVING_DOWN_LEFT; }
-    else if (right && !left) { m_movementState = stop ? State::MOVING_RIGHT : State::MOVING_DOWN_RIGHT; }
-    else { m_movementState = stop ? State::IDLE : State::MOVING_DOWN; }
+    State& state = m_movementState[index];
+    if (up && !down) { state = stop ? State::MOVING_UP : State::MOVING_UP_LEFT; }
+    else if (down && !up) { state = stop ? State::MOVING_DOWN : State::MOVING_DOWN_LEFT; }
+    else { state = stop ? State::IDLE : State::MOVING_LEFT; }
 }
 
-void PF::Player::handleMoveLeft(const bool stop)
+void PF::PlayerStore::handleMoveRight(std::size_t index, const bool stop)
 {
-    const bool up = isMovingUp();
-    const bool down = isMovingDown();
+    const bool up = isMovingUp(index);
+    const bool down = isMovingDown(index);
 
-    if (up && !down) { m_movementState = stop ? State::MOVING_UP : State::MOVING_UP_LEFT; }
-    else if (down && !up) { m_movementState = stop ? State::MOVING_DOWN : State::MOVING_DOWN_LEFT; }
-    else { m_movementState = stop ? State::IDLE : State::MOVING_LEFT; }
+    State& state = m_movementState[index];
+    if (up && !down) { state = stop ? State::MOVING_UP : State::MOVING_UP_RIGHT; }
+    else if (down && !up) { state = stop ? State::MOVING_DOWN : State::MOVING_DOWN_RIGHT; }
+    else { state = stop ? State::IDLE : State::MOVING_RIGHT; }
 }
 
-void PF::Player::handleMoveRight(const bool stop)
+void PF::PlayerStore::handleEvent(PF::PlayerIntention playerIntention)
 {
-    const bool up = isMovingUp();
-    const bool down = isMovingDown();
+    if (playerIntention == PF::PlayerIntention::NONE) { return; }
+
+    for (std::size_t pair = 0; pair < INTENTION_PAIR_COUNT; ++pair)
+    {
+        if (playerIntention == INTENTION_PAIRS[pair].start)
+        {
+            m_startedThisStep[pair] = 1;
+            m_stopDeferred[pair] = 0;  // Pressed again before the step, so the earlier release no longer applies
+        }
+        else if (playerIntention == INTENTION_PAIRS[pair].stop && m_startedThisStep[pair] != 0)
+        {
+            m_stopDeferred[pair] = 1;  // Held back until the step has seen the start
+            return;
+        }
+    }
 
-    if (up && !down) { m_movementState = stop ? State::MOVING_UP : State::MOVING_UP_RIGHT; }
-    else if (down && !up) { m_movementState = stop ? State::MOVING_DOWN : State::MOVING_DOWN_RIGHT; }
-    else { m_movementState = stop ? State::IDLE : State::MOVING_RIGHT; }
+    const std::size_t count = m_columns.count();
+    for (std::size_t i = 0; i < count; ++i) { handleEvent(i, playerIntention); }
 }
 
-void PF::Player::handleEvent(PF::PlayerIntention playerIntention)
+void PF::PlayerStore::receiveIntention(PF::PlayerIntention playerIntention) { handleEvent(playerIntention); }
+
+void PF::PlayerStore::handleEvent(std::size_t index, PF::PlayerIntention playerIntention)
 {
     switch (playerIntention)
     {
         case PF::PlayerIntention::ATTACK:
         {
-            handleAttackIntention(false /*stop*/);
+            handleAttackIntention(index, false /*stop*/);
             break;
         }
         case PF::PlayerIntention::ATTACK_STOP:
         {
-            handleAttackIntention(true /*stop*/);
+            handleAttackIntention(index, true /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_UP:
         {
-            handleMoveUp(false /*stop*/);
+            handleMoveUp(index, false /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_DOWN:
         {
-            handleMoveDown(false /*stop*/);
+            handleMoveDown(index, false /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_LEFT:
         {
-            handleMoveLeft(false /*stop*/);
+            handleMoveLeft(index, false /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_RIGHT:
         {
-            handleMoveRight(false /*stop*/);
+            handleMoveRight(index, false /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_STOP_UP:
         {
-            handleMoveUp(true /*stop*/);
+            handleMoveUp(index, true /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_STOP_DOWN:
         {
-            handleMoveDown(true /*stop*/);
+            handleMoveDown(index, true /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_STOP_LEFT:
         {
-            handleMoveLeft(true /*stop*/);
+            handleMoveLeft(index, true /*stop*/);
             break;
         }
         case PF::PlayerIntention::MOVE_STOP_RIGHT:
         {
-            handleMoveRight(true /*stop*/);
+            handleMoveRight(index, true /*stop*/);
             break;
         }
 
@@ -254,71 +331,54 @@ void PF::Player::handleEvent(PF::PlayerIntention playerIntention)
     }
 }
 
-std::shared_ptr<PF::Object> PF::Player::spawnChildObject()
+void PF::PlayerStore::spawnAttacks(PF::ParticleSystem& particles)
 {
-    if (m_needToSpawnAttack)
+    const std::size_t count = m_columns.count();
+    for (std::size_t i = 0; i < count; ++i)
     {
-        m_needToSpawnAttack = false;       // Reset the flag after spawning the attack
-        m_lastAttackTime = m_playerClock;  // Update the last attack time
-        return spawnAttack();              // Spawn an attack object
-    }
-    return nullptr;  // No child object to spawn
-}
-
-std::shared_ptr<PF::Object> PF::Player::spawnAttack() const
-{
-    const float velocitySum = (m_velocity.x * m_velocity.x) + (m_velocity.y * m_velocity.y);
-    SDL_FPoint attackVelocity = m_velocity;
-    if (velocitySum < MIN_VELOCITY_THRESHOLD) { attackVelocity = m_lastVelocity; }
-
-    float size = m_size * ATTACK_SIZE_FACTOR;
-    auto attack = std::make_shared<PF::Attack>(m_textureIdx, m_srcRect, m_position, size);
+        if (m_needToSpawnAttack[i] == 0) { continue; }
 
-    attackVelocity.x *= ATTACK_VELOCITY_MULTIPLIER * (0.6F + SDL_randf() * 0.4F);  // Randomize attack velocity
-    attackVelocity.y *= ATTACK_VELOCITY_MULTIPLIER * (0.6F + SDL_randf() * 0.4F);
-    attack->setVelocity(attackVelocity);  // Set the velocity of the attack
-    return attack;
+        m_needToSpawnAttack[i] = 0;              // Reset the flag after spawning the attack
+        m_lastAttackTime[i] = m_playerClock[i];  // Update the last attack time
+        spawnAttack(i, particles);               // Fire an attack
+    }
 }
 
-PF::Attack::Attack(std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size)
-    : Object(textureIdx, srcRect, position, size)
+void PF::PlayerStore::spawnAttack(std::size_t index, PF::ParticleSystem& particles)
 {
+    const float velocityX = m_columns.velocityX[index];
+    const float velocityY = m_columns.velocityY[index];
+    const float velocitySum = (velocityX * velocityX) + (velocityY * velocityY);
+    SDL_FPoint attackVelocity = {velocityX, velocityY};
+    if (velocitySum < PF::Global::Model::MIN_VELOCITY_THRESHOLD) { attackVelocity = m_lastVelocity[index]; }
+
+    // The emitters scale and jitter the attack, drawing from the player's generator so it follows the player's seed
+    const PF::EntityRef owner = {.kind = KIND, .index = static_cast<std::uint32_t>(index)};
+    const SDL_FPoint position = {m_columns.positionX[index], m_columns.positionY[index]};
+    particles.emitFrom(owner, position, attackVelocity, m_columns.size[index], m_columns.randomState[index]);
 }
 
-void PF::Attack::update(Uint64 stepMs)
+void PF::PlayerStore::capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const
 {
-    m_angle += static_cast<float>(stepMs) * ATTACK_ANGLE_INCREMENT * SDL_randf();  // Randomize angle increment
-    float sinAngle = sinf(m_angle);
-    float cosAngle = cosf(COS_ANGLE_MULTIPLIER * m_angle);
-
-    m_position.x += m_velocity.x * (1 + sinAngle) + POSITION_OFFSET * sinAngle;  // Update position based on velocity
-    m_position.y += m_velocity.y * (1 + cosAngle) + POSITION_OFFSET * cosAngle;  // Update position based on velocity
-
-    // Decelerate x velocity based on proportion of x/y velocity
-    if (m_velocity.x > MIN_VELOCITY_THRESHOLD) { m_velocity.x -= ATTACK_DECELERATION; }
-    else if (m_velocity.x < -MIN_VELOCITY_THRESHOLD) { m_velocity.x += ATTACK_DECELERATION; }
-    else { m_velocity.x = 0.0F; }
-
-    // Decelerate y velocity based on inverse proportion of x/y velocity
-    if (m_velocity.y > MIN_VELOCITY_THRESHOLD) { m_velocity.y -= ATTACK_DECELERATION; }
-    else if (m_velocity.y < -MIN_VELOCITY_THRESHOLD) { m_velocity.y += ATTACK_DECELERATION; }
-    else { m_velocity.y = 0.0F; }
-
-    m_size = m_size + (sinf(m_angle * 3) * ATTACK_SIZE_OSCILLATION) - ATTACK_SIZE_DECAY * m_angle;
+    const std::size_t count = m_columns.count();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Whatever the render thread interpolates to lies within the area swept during the step
+        const SDL_FRect previous = m_columns.dstRect(i, 0.0F);
+        const SDL_FRect current = m_columns.dstRect(i);
+        SDL_FRect swept;
+        SDL_GetRectUnionFloat(&previous, &current, &swept);
+        if (!camera.isVisible(swept)) { continue; }
+
+        snapshot.sprites.push_back({.previousPosition = {m_columns.previousX[i], m_columns.previousY[i]},
+                                    .position = {m_columns.positionX[i], m_columns.positionY[i]},
+                                    .extent = {current.w, current.h},
+                                    .angle = 0.0F,
+                                    .textureIdx = m_columns.textureIdx[i],
+                                    .srcRect = m_columns.srcRect[i]});
+    }
 }
 
-void PF::Attack::setVelocity(SDL_FPoint velocity) { m_velocity = velocity; }
-
-bool PF::Attack::shouldRemove() const { return m_size < MIN_ATTACK_SIZE; }
+std::size_t PF::PlayerStore::count() const { return m_columns.count(); }
 
-void PF::Attack::render(SDL_Renderer* renderer, const PF::TextureManager& textureManager) const
-{
-    auto& texture = textureManager.getTexture(m_textureIdx).get();
-    const auto width = m_srcRect.w * m_size;
-    const auto height = m_srcRect.h * m_size;
-    SDL_FRect dstRect = {(m_position.x - (width / 2)), (m_position.y - (height / 2)), width, height};
-    const bool success =
-        SDL_RenderTextureRotated(renderer, &texture, &m_srcRect, &dstRect, m_angle * 180.0F, nullptr, SDL_FLIP_NONE);
-    // SDL_RenderTexture(renderer, &texture, &m_srcRect, &dstRect);
-    if (!success) { throw PF::SDLException("Failed to render texture"); }
-}
+const PF::EntityColumns& PF::PlayerStore::getColumns() const { return m_columns; }
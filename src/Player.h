@@ -2,17 +2,31 @@
 
 #include <SDL3/SDL.h>
 
+#include <array>
 #include <cstddef>
-#include <memory>
+#include <vector>
 
+#include "EntityColumns.h"
 #include "Enums.h"
-#include "Object.h"
+#include "InputRouter.h"
 
 namespace PF
 {
-constexpr float DEFAULT_DECELERATION = 0.025F;
-
-class Player : public Object
+class Camera;
+class JobSystem;
+class ParticleSystem;
+struct RenderSnapshot;
+
+/**
+ * @class PlayerStore
+ * @brief Holds every player-controlled jelly form as contiguous columns.
+ *
+ * The shared transform columns live in an EntityColumns block, and the movement/attack state machine of each player
+ * lives in parallel columns indexed the same way. Players receive their intentions from an InputRouter. A stop that
+ * arrives in the same step as its start is held back until that step is over, so a quick tap still moves or attacks
+ * once.
+ */
+class PlayerStore : public PF::IntentionReceiver
 {
     enum class State
     {
@@ -29,61 +43,74 @@ class Player : public Object
     };
 
   public:
-    Player(std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size);
+    static constexpr PF::EntityKind KIND = PF::EntityKind::PLAYER;
+    static constexpr std::size_t INTENTION_PAIR_COUNT = 5;  // Each movement direction, and the attack
 
-    void update(Uint64 stepMs) override;
+    /**
+     * @brief Adds a new player.
+     * @param seed The initial state of the player's random generator, which also seeds its attacks.
+     * @return The index of the new player.
+     */
+    std::size_t add(std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size, Uint64 seed);
 
-    void handleEvent(PF::PlayerIntention playerIntention) override;
+    /**
+     * @brief Advances every player by one step. Players are too few to be worth splitting across the job system.
+     */
+    void update(Uint64 stepMs, PF::JobSystem& jobSystem);
 
-    [[nodiscard]]
-    std::shared_ptr<Object> spawnChildObject() override;
+    /**
+     * @brief Does nothing: players never expire. Present so players fit EntityKindStore.
+     */
+    void removeExpired();
 
-  private:
-    [[nodiscard]]
-    std::shared_ptr<PF::Object> spawnAttack() const;
+    void handleEvent(PF::PlayerIntention playerIntention);
 
-    void handleAttackIntention(bool stop);
-    void handleMoveUp(bool stop);
-    void handleMoveDown(bool stop);
-    void handleMoveLeft(bool stop);
-    void handleMoveRight(bool stop);
+    void receiveIntention(PF::PlayerIntention playerIntention) override;
 
-    [[nodiscard]] bool isMovingUp() const;
-    [[nodiscard]] bool isMovingDown() const;
-    [[nodiscard]] bool isMovingLeft() const;
-    [[nodiscard]] bool isMovingRight() const;
+    /**
+     * @brief Fires an attack for every player whose attack cooldown elapsed, through the emitters attached to it.
+     * @param particles The particle system holding the emitters.
+     */
+    void spawnAttacks(PF::ParticleSystem& particles);
 
-  private:
-    Uint64 m_playerClock = 0;  // Player clock for timing
+    /**
+     * @brief Appends a sprite to `snapshot` for every entity the camera sees at either end of the last step.
+     */
+    void capture(PF::RenderSnapshot& snapshot, const PF::Camera& camera) const;
 
-    State m_movementState = State::IDLE;  // Current state of the player movement
-    State m_actionState = State::IDLE;    // Current state of the player action
+    [[nodiscard]] std::size_t count() const;
+    [[nodiscard]] const PF::EntityColumns& getColumns() const;
 
-    bool m_needToSpawnAttack = false;  // Flag to indicate if an attack should be spawned
-    Uint64 m_lastAttackTime = 0;       // Last time the attack was performed
+  private:
+    void updateVelocity(std::size_t index);
+    void spawnAttack(std::size_t index, PF::ParticleSystem& particles);
 
-    float m_angle = 0.0F;                      // Angle for circular motion
-    SDL_FPoint m_velocity = {0.0F, 0.0F};      // Velocity vector for movement
-    SDL_FPoint m_lastVelocity = {0.0F, 0.0F};  // Last velocity vector for movement
-};
+    void handleEvent(std::size_t index, PF::PlayerIntention playerIntention);
+    void handleAttackIntention(std::size_t index, bool stop);
+    void handleMoveUp(std::size_t index, bool stop);
+    void handleMoveDown(std::size_t index, bool stop);
+    void handleMoveLeft(std::size_t index, bool stop);
+    void handleMoveRight(std::size_t index, bool stop);
 
-class Attack : public Object
-{
-  public:
-    Attack(std::size_t textureIdx, SDL_FRect srcRect, SDL_FPoint position, float size);
+    [[nodiscard]] bool isMovingUp(std::size_t index) const;
+    [[nodiscard]] bool isMovingDown(std::size_t index) const;
+    [[nodiscard]] bool isMovingLeft(std::size_t index) const;
+    [[nodiscard]] bool isMovingRight(std::size_t index) const;
 
-    void update(Uint64 stepMs) override;
+  private:
+    PF::EntityColumns m_columns;  // Transform columns shared with every entity kind
 
-    void render(SDL_Renderer* renderer, const PF::TextureManager& textureManager) const override;
+    std::vector<Uint64> m_playerClock;  // Player clock for timing
 
-    void setVelocity(SDL_FPoint velocity);
+    std::vector<State> m_movementState;  // Current state of the player movement
+    std::vector<State> m_actionState;    // Current state of the player action
 
-    [[nodiscard]]
-    bool shouldRemove() const override;
+    std::vector<Uint8> m_needToSpawnAttack;  // Flag to indicate if an attack should be spawned
+    std::vector<Uint64> m_lastAttackTime;    // Last time the attack was performed
 
-  private:
-    float m_angle = 0.0F;  // Angle for circular motion
-    SDL_FPoint m_velocity = {0.0F, 0.0F};
-    float m_deceleration = DEFAULT_DECELERATION;  // Deceleration factor for attack movement
+    std::vector<SDL_FPoint> m_lastVelocity;  // Last velocity vector for movement
+
+    std::array<Uint8, INTENTION_PAIR_COUNT> m_startedThisStep{};  // Set when a start arrived since the last step
+    std::array<Uint8, INTENTION_PAIR_COUNT> m_stopDeferred{};     // Set when its stop is held back until the step
 };
 }  // namespace PF
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "Exceptions.h"
+#include "Log.h"
+#include "Profiler.h"
+
+constexpr float OVERLAY_MARGIN = 8.0F;
+constexpr float OVERLAY_LINE_HEIGHT = 10.0F;  // SDL_RenderDebugText glyphs are 8 pixels high
+constexpr float GRAPH_HEIGHT = 60.0F;
+constexpr float GRAPH_MAX_MS = 33.3F;     // Frame time at the top of the graph
+constexpr float GRAPH_TARGET_MS = 16.6F;  // Frame time marked by the reference line
+constexpr double NANOSECONDS_PER_MILLISECOND = 1e6;
+constexpr double NANOSECONDS_PER_MICROSECOND = 1e3;
+constexpr std::uint64_t LAP_MARGIN = 1024;  // Oldest zones of a ring left unread, a thread may be overwriting them
+
+namespace
+{
+struct ThreadBuffer
+{
+    std::uint32_t threadId = 0;
+    std::vector<PF::Profiler::ZoneEvent> events;  // Sized once at registration, so recording never allocates
+    std::atomic<std::uint64_t> written{0};        // Zones ever recorded, the ring holds the last EVENTS_PER_THREAD
+    std::uint64_t frameStart = 0;                 // Value of `written` when the current frame started
+    std::uint32_t depth = 0;                      // Zones currently open on the thread
+};
+
+struct FrameRecord
+{
+    Uint64 startNs = 0;
+    Uint64 endNs = 0;
+};
+
+struct ProfilerState
+{
+    std::mutex registryMutex;                            // Guards `buffers` while threads register
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // Kept after their thread exits, for the trace
+    std::array<FrameRecord, PF::Profiler::FRAME_HISTORY> frames{};
+    std::size_t frameCount = 0;
+    Uint64 frameStartNs = 0;
+    std::vector<PF::Profiler::ZoneStats> lastFrameStats;
+};
+
+ProfilerState& GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        ProfilerState& state = GetState();
+        const std::scoped_lock lock(state.registryMutex);
+        state.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = state.buffers.back().get();
+        buffer->threadId = static_cast<std::uint32_t>(state.buffers.size());
+        buffer->events.resize(PF::Profiler::EVENTS_PER_THREAD);
+    }
+    return *buffer;
+}
+
+float ToMilliseconds(Uint64 ns) { return static_cast<float>(static_cast<double>(ns) / NANOSECONDS_PER_MILLISECOND); }
+
+/**
+ * @brief Visits the zones recorded from `first` on, and returns the count they were read up to.
+ */
+template<typename Visitor>
+std::uint64_t ForEachEvent(const ThreadBuffer& buffer, std::uint64_t first, Visitor&& visitor)
+{
+    // The owning thread may still be recording: read what it published, and skip the oldest zones, which it may be
+    // overwriting or has already overwritten
+    const std::uint64_t written = buffer.written.load(std::memory_order_acquire);
+    const std::uint64_t kept = PF::Profiler::EVENTS_PER_THREAD - LAP_MARGIN;
+    first = std::max(first, written - std::min(written, kept));
+    for (std::uint64_t i = first; i < written; ++i) { visitor(buffer.events[i % PF::Profiler::EVENTS_PER_THREAD]); }
+    return written;
+}
+}  // namespace
+
+PF::Profiler::Zone::Zone(const char* name)
+    : m_name(name), m_startNs(SDL_GetTicksNS()), m_startAllocations(PF::AllocationTracker::getThreadCounts())
+{
+    ++GetThreadBuffer().depth;
+}
+
+PF::Profiler::Zone::~Zone()
+{
+    const Uint64 endNs = SDL_GetTicksNS();
+    const PF::AllocationTracker::AllocationCounts allocations =
+        PF::AllocationTracker::getThreadCounts() - m_startAllocations;
+    ThreadBuffer& buffer = GetThreadBuffer();
+    --buffer.depth;
+    const std::uint64_t written = buffer.written.load(std::memory_order_relaxed);  // Only this thread writes it
+    buffer.events[written % EVENTS_PER_THREAD] = {
+        .name = m_name, .startNs = m_startNs, .endNs = endNs, .depth = buffer.depth, .allocations = allocations};
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void PF::Profiler::endFrame()
+{
+    ProfilerState& state = GetState();
+    const Uint64 nowNs = SDL_GetTicksNS();
+    if (state.frameStartNs != 0)
+    {
+        state.frames[state.frameCount % FRAME_HISTORY] = {.startNs = state.frameStartNs, .endNs = nowNs};
+        ++state.frameCount;
+    }
+    state.frameStartNs = nowNs;
+
+    // Zone names are string literals: the same zone always has the same pointer
+    state.lastFrameStats.clear();
+    const std::scoped_lock lock(state.registryMutex);
+    for (const auto& buffer : state.buffers)
+    {
+        buffer->frameStart =
+            ForEachEvent(*buffer,
+                         buffer->frameStart,
+                         [&](const ZoneEvent& event)
+                         {
+                             auto stats = std::ranges::find(state.lastFrameStats, event.name, &ZoneStats::name);
+                             if (stats == state.lastFrameStats.end())
+                             {
+                                 state.lastFrameStats.push_back({.name = event.name});
+                                 stats = state.lastFrameStats.end() - 1;
+                             }
+                             stats->totalNs += event.endNs - event.startNs;
+                             ++stats->calls;
+                             stats->allocations.allocations += event.allocations.allocations;
+                             stats->allocations.bytes += event.allocations.bytes;
+                         });
+    }
+}
+
+const std::vector<PF::Profiler::ZoneStats>& PF::Profiler::getLastFrameStats() { return GetState().lastFrameStats; }
+
+std::vector<Uint64> PF::Profiler::getFrameDurations()
+{
+    const ProfilerState& state = GetState();
+    const std::size_t count = std::min(state.frameCount, FRAME_HISTORY);
+
+    std::vector<Uint64> durations;
+    durations.reserve(count);
+    for (std::size_t i = state.frameCount - count; i < state.frameCount; ++i)
+    {
+        const FrameRecord& frame = state.frames[i % FRAME_HISTORY];
+        durations.push_back(frame.endNs - frame.startNs);
+    }
+    return durations;
+}
+
+void PF::Profiler::drawOverlay(SDL_Renderer* renderer, const std::vector<std::string>& extraLines)
+{
+    const std::vector<Uint64> durations = getFrameDurations();
+
+    // Frame time graph: one bar per frame, the latest on the right
+    std::vector<SDL_FRect> bars;
+    bars.reserve(durations.size());
+    const float graphBottom = OVERLAY_MARGIN + GRAPH_HEIGHT;
+    for (std::size_t i = 0; i < durations.size(); ++i)
+    {
+        const float height = std::min(ToMilliseconds(durations[i]) / GRAPH_MAX_MS, 1.0F) * GRAPH_HEIGHT;
+        bars.push_back({OVERLAY_MARGIN + static_cast<float>(i), graphBottom - height, 1.0F, height});
+    }
+    const float targetY = graphBottom - ((GRAPH_TARGET_MS / GRAPH_MAX_MS) * GRAPH_HEIGHT);
+    const auto graphWidth = static_cast<float>(FRAME_HISTORY);
+
+    bool drawn = SDL_SetRenderDrawColorFloat(renderer, 0.0F, 1.0F, 0.0F, SDL_ALPHA_OPAQUE_FLOAT);
+    drawn = drawn && (bars.empty() || SDL_RenderFillRects(renderer, bars.data(), static_cast<int>(bars.size())));
+    drawn = drawn && SDL_SetRenderDrawColorFloat(renderer, 1.0F, 0.0F, 0.0F, SDL_ALPHA_OPAQUE_FLOAT);
+    drawn = drawn && SDL_RenderLine(renderer, OVERLAY_MARGIN, targetY, OVERLAY_MARGIN + graphWidth, targetY);
+
+    // Text: last frame time, zones of the last frame, then whatever the caller wants to show
+    std::vector<std::string> lines;
+    lines.push_back(std::format("frame {:.2f} ms", durations.empty() ? 0.0F : ToMilliseconds(durations.back())));
+    for (const ZoneStats& stats : getLastFrameStats())
+    {
+        std::string line = std::format("{:<24} {:7.3f} ms x{}", stats.name, ToMilliseconds(stats.totalNs), stats.calls);
+        if constexpr (PF::AllocationTracker::ENABLED)
+        {
+            line += std::format(" alloc {} ({} B)", stats.allocations.allocations, stats.allocations.bytes);
+        }
+        lines.push_back(std::move(line));
+    }
+    lines.insert(lines.end(), extraLines.begin(), extraLines.end());
+    if constexpr (!PF_PROFILER_ENABLED) { lines.emplace_back("profiler zones compiled out"); }
+
+    drawn = drawn && SDL_SetRenderDrawColorFloat(renderer, 1.0F, 1.0F, 1.0F, SDL_ALPHA_OPAQUE_FLOAT);
+    float y = graphBottom + OVERLAY_MARGIN;
+    for (const std::string& line : lines)
+    {
+        drawn = drawn && SDL_RenderDebugText(renderer, OVERLAY_MARGIN, y, line.c_str());
+        y += OVERLAY_LINE_HEIGHT;
+    }
+    if (!drawn) { throw PF::SDLException("Failed to draw profiler overlay."); }
+}
+
+void PF::Profiler::dumpChromeTrace(std::string_view filePath)
+{
+    const auto toUs = [](Uint64 ns) { return static_cast<double>(ns) / NANOSECONDS_PER_MICROSECOND; };
+    std::ofstream output{std::string{filePath}};
+    output << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    const auto writeEvent = [&](std::string_view name, Uint64 startNs, Uint64 endNs, std::uint32_t threadId)
+    {
+        output << std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                              first ? "" : ",\n",
+                              name,
+                              threadId,
+                              toUs(startNs),
+                              toUs(endNs - startNs));
+        first = false;
+    };
+
+    // Frames get a track of their own, thread 0, above the threads' zones
+    output << R"({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"Frames"}})";
+    first = false;
+    ProfilerState& state = GetState();
+    for (std::size_t i = state.frameCount - std::min(state.frameCount, FRAME_HISTORY); i < state.frameCount; ++i)
+    {
+        const FrameRecord& frame = state.frames[i % FRAME_HISTORY];
+        writeEvent("Frame", frame.startNs, frame.endNs, 0);
+    }
+    const std::scoped_lock lock(state.registryMutex);
+    for (const auto& buffer : state.buffers)
+    {
+        ForEachEvent(*buffer,
+                     0,
+                     [&](const ZoneEvent& event)
+                     { writeEvent(event.name, event.startNs, event.endNs, buffer->threadId); });
+    }
+    output << "\n]}\n";
+
+    if (!output) { throw PF::Exception(std::format("Failed to write Chrome trace to {}", filePath)); }
+    PF_LOG_INFO("Chrome trace written to %s", filePath);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AllocationTracker.h"
+
+#ifndef PF_PROFILER_ENABLED
+#define PF_PROFILER_ENABLED 1
+#endif
+
+#define PF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PF_PROFILE_CONCAT(a, b) PF_PROFILE_CONCAT_IMPL(a, b)
+
+#if PF_PROFILER_ENABLED
+/**
+ * @brief Measures the enclosing scope as a zone named `name`, which must be a string literal.
+ */
+#define PF_PROFILE_ZONE(name) const PF::Profiler::Zone PF_PROFILE_CONCAT(pfProfileZone, __LINE__)(name)
+#else
+#define PF_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+/**
+ * @brief Scoped-zone frame profiler.
+ *
+ * Every thread records the zones it closes into its own fixed-size ring buffer, so recording takes no lock and never
+ * allocates once the thread's buffer exists. The oldest zones are overwritten once a buffer is full.
+ *
+ * The buffers are read by endFrame(), drawOverlay() and dumpChromeTrace(), on the main thread between two frames.
+ * Other threads, such as the simulation thread, may keep recording meanwhile: every buffer publishes its zones through
+ * an atomic counter, and readers leave alone the oldest zones of a ring, which its thread may be overwriting.
+ *
+ * With allocation tracking compiled in, see AllocationTracker.h, zones also count the heap allocations their thread
+ * made while they were open.
+ *
+ * Building with PF_PROFILER_ENABLED set to 0 (CMake option PERFECTFORM_PROFILER) turns PF_PROFILE_ZONE into nothing.
+ */
+namespace PF::Profiler
+{
+constexpr std::size_t EVENTS_PER_THREAD = 16384;  // Ring buffer size of every thread
+constexpr std::size_t FRAME_HISTORY = 240;        // Frames kept for the overlay graph and the trace
+
+/**
+ * @struct ZoneEvent
+ * @brief A closed zone.
+ */
+struct ZoneEvent
+{
+    const char* name = nullptr;
+    Uint64 startNs = 0;
+    Uint64 endNs = 0;
+    std::uint32_t depth = 0;  // Number of zones open around this one on the same thread
+    PF::AllocationTracker::AllocationCounts allocations{};  // Made by the thread while the zone was open
+};
+
+/**
+ * @struct ZoneStats
+ * @brief Time spent in one zone name during a frame, summed over every thread.
+ */
+struct ZoneStats
+{
+    const char* name = nullptr;
+    Uint64 totalNs = 0;
+    std::size_t calls = 0;
+    PF::AllocationTracker::AllocationCounts allocations{};
+};
+
+/**
+ * @class Zone
+ * @brief Records the time between its construction and destruction. Use through PF_PROFILE_ZONE.
+ */
+class Zone
+{
+  public:
+    explicit Zone(const char* name);
+    ~Zone();
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+    Zone(Zone&&) = delete;
+    Zone& operator=(Zone&&) = delete;
+
+  private:
+    const char* m_name;
+    Uint64 m_startNs;
+    PF::AllocationTracker::AllocationCounts m_startAllocations;
+};
+
+/**
+ * @brief Closes the current frame: records its duration and sums up the zones closed during it.
+ */
+void endFrame();
+
+/**
+ * @brief Gets the zones of the last frame closed by endFrame(), in the order they were first closed.
+ */
+[[nodiscard]] const std::vector<ZoneStats>& getLastFrameStats();
+
+/**
+ * @brief Gets the duration of the last FRAME_HISTORY frames, oldest first.
+ */
+[[nodiscard]] std::vector<Uint64> getFrameDurations();
+
+/**
+ * @brief Draws the frame time graph, the zones of the last frame and `extraLines` in the top-left corner.
+ * @throws PF::SDLException if drawing fails.
+ */
+void drawOverlay(SDL_Renderer* renderer, const std::vector<std::string>& extraLines);
+
+/**
+ * @brief Writes every zone still in the ring buffers, and the frames in the history, as a Chrome trace.
+ *
+ * Open the file in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * @throws PF::Exception if the file cannot be written.
+ */
+void dumpChromeTrace(std::string_view filePath);
+}  // namespace PF::Profiler
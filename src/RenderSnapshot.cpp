@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cstddef>
+
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
+#include "TextureManager.h"
+
+namespace
+{
+/**
+ * @brief Queues `sprite` at its interpolated position, unless the camera does not see it there.
+ */
+void DrawSprite(PF::SpriteBatch& spriteBatch,
+                const PF::TextureManager& textureManager,
+                const PF::Camera& camera,
+                const PF::SpriteSnapshot& sprite,
+                float alpha)
+{
+    const float x = sprite.previousPosition.x + ((sprite.position.x - sprite.previousPosition.x) * alpha);
+    const float y = sprite.previousPosition.y + ((sprite.position.y - sprite.previousPosition.y) * alpha);
+    const SDL_FRect dstRect = {x - (sprite.extent.x / 2), y - (sprite.extent.y / 2), sprite.extent.x, sprite.extent.y};
+    if (!camera.isVisible(dstRect, sprite.angle)) { return; }
+
+    // The level of detail closest to the size on screen, so small sprites sample a small copy of their image
+    const SDL_FRect screenRect = camera.worldToScreen(dstRect);
+    const PF::AtlasRegion& region = textureManager.getRegion(sprite.textureIdx, screenRect.w / sprite.srcRect.w);
+    auto& texture = textureManager.getPage(region.page).get();
+    spriteBatch.draw(&texture, region.toPage(sprite.srcRect), screenRect, sprite.angle);
+}
+}  // namespace
+
+float PF::RenderSnapshot::getAlpha(Uint64 nowNs, Uint64 stepNs) const
+{
+    if (nowNs <= stateTimeNs) { return 0.0F; }
+    return std::min(static_cast<float>(nowNs - stateTimeNs) / static_cast<float>(stepNs), 1.0F);
+}
+
+void PF::RenderSnapshot::draw(PF::SpriteBatch& spriteBatch, const PF::TextureManager& textureManager, float alpha) const
+{
+    for (const PF::SpriteSnapshot& sprite : sprites) { DrawSprite(spriteBatch, textureManager, camera, sprite, alpha); }
+
+    for (const PF::ParticleBatchSnapshot& batch : particleBatches)
+    {
+        for (std::size_t i = batch.first; i < batch.first + batch.count; ++i)
+        {
+            const PF::ParticleSnapshot& particle = particles[i];
+            const PF::SpriteSnapshot sprite = {
+                .previousPosition = particle.previousPosition,
+                .position = particle.position,
+                .extent = {batch.srcRect.w * particle.size, batch.srcRect.h * particle.size},
+                .angle = particle.angle,
+                .textureIdx = batch.textureIdx,
+                .srcRect = batch.srcRect};
+            DrawSprite(spriteBatch, textureManager, camera, sprite, alpha);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "Camera.h"
+#include "Enums.h"
+
+namespace PF
+{
+class SpriteBatch;
+class TextureManager;
+
+/**
+ * @struct SpriteSnapshot
+ * @brief What the renderer needs of one entity: where it was and is, what to draw, and how rotated.
+ */
+struct SpriteSnapshot
+{
+    SDL_FPoint previousPosition = {0, 0};  // World position of the centre before the last step
+    SDL_FPoint position = {0, 0};          // World position of the centre after the last step
+    SDL_FPoint extent = {0, 0};            // World width and height
+    float angle = 0.0F;                    // Clockwise rotation, in degrees
+    std::size_t textureIdx = 0;            // Atlas handle in the TextureManager
+    SDL_FRect srcRect = {0, 0, 0, 0};      // Source rectangle inside the texture
+};
+
+/**
+ * @struct ParticleSnapshot
+ * @brief What the renderer needs of one particle, the rest being shared by its batch.
+ */
+struct ParticleSnapshot
+{
+    SDL_FPoint previousPosition = {0, 0};  // World position of the centre before the last step
+    SDL_FPoint position = {0, 0};          // World position of the centre after the last step
+    float size = 0.0F;                     // Scale applied to the batch's source rectangle
+    float angle = 0.0F;                    // Clockwise rotation, in degrees
+};
+
+/**
+ * @struct ParticleBatchSnapshot
+ * @brief A run of particles of one emitter, all drawn with the same texture.
+ */
+struct ParticleBatchSnapshot
+{
+    std::size_t textureIdx = 0;        // Atlas handle in the TextureManager
+    SDL_FRect srcRect = {0, 0, 0, 0};  // Source rectangle inside the texture
+    std::size_t first = 0;             // Index of the first particle in RenderSnapshot::particles
+    std::size_t count = 0;
+};
+
+/**
+ * @struct RenderSnapshot
+ * @brief Everything needed to draw one simulation state, copied out of the game so the simulation can move on.
+ *
+ * The simulation thread fills a snapshot after its steps and publishes it; the render thread only ever reads
+ * published snapshots, so the two never share entity data. Sprites are culled loosely when captured, against both
+ * their previous and current rectangles, and exactly when drawn, once interpolated. Particles come after the
+ * sprites, grouped by emitter, so each emitter's particles end up in a single run of the sprite batch.
+ */
+struct RenderSnapshot
+{
+    std::vector<PF::SpriteSnapshot> sprites;                 // Back to front
+    std::vector<PF::ParticleSnapshot> particles;             // Drawn over the sprites, batch after batch
+    std::vector<PF::ParticleBatchSnapshot> particleBatches;  // In emitter order
+    PF::Camera camera{{0.0F, 0.0F}, {0.0F, 0.0F}};
+    std::array<std::size_t, static_cast<std::size_t>(PF::EntityKind::EntityKind_Last)> entityCounts{};
+    std::size_t particleCount = 0;          // Live particles, seen or not
+    std::size_t particleHighWaterMark = 0;  // See ParticleSystem::getHighWaterMark()
+    Uint64 tick = 0;              // Number of steps the state is the result of
+    Uint64 stateTimeNs = 0;       // Wall-clock time the state is current at, see FixedTimestep::getStateTimeNs()
+    bool replayFinished = false;  // Whether a running replay reached the recording's last tick
+
+    // Made by the simulation thread during the last step, see Game::m_tickAllocations
+    PF::AllocationTracker::AllocationCounts tickAllocations{};
+
+    /**
+     * @brief Gets how far past the state to draw at `nowNs`, from 0 (previous positions) to 1 (current positions).
+     */
+    [[nodiscard]] float getAlpha(Uint64 nowNs, Uint64 stepNs) const;
+
+    /**
+     * @brief Queues every sprite and particle the camera sees into the frame's sprite batch, between its two
+     * positions.
+     */
+    void draw(PF::SpriteBatch& spriteBatch, const PF::TextureManager& textureManager, float alpha) const;
+};
+}  // namespace PF
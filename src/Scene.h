@@ -1,16 +1,21 @@
-#include <SDL3/SDL.h>
+#pragma once
 
-#include <memory>
-#include <utility>
+#include <SDL3/SDL.h>
 
 namespace PF
 {
-class TextureManager;
+/**
+ * @class Scene
+ * @brief A self-contained part of the application, such as a level or a menu, driven by the SceneManager.
+ *
+ * A scene must be constructible on any thread: the manager builds the next one in the background while the current
+ * one keeps running. Everything touching the renderer therefore waits for uploadTextures(), which the manager always
+ * calls on the render thread.
+ */
 class Scene
 {
   public:
-    explicit Scene(std::shared_ptr<const PF::TextureManager> textureManager)
-        : m_textureManager(std::move(textureManager)) {};
+    Scene() = default;
     virtual ~Scene() = default;
 
     // Deleted copy and move constructors and assignment operators
@@ -19,14 +24,29 @@ class Scene
     Scene(Scene&&) = delete;
     Scene& operator=(Scene&&) = delete;
 
+    /**
+     * @brief Advances the scene by one fixed step. Called by the simulation thread, see SimulationThread.
+     */
     virtual void update(Uint64 stepMs) = 0;
 
-    // TODO: update this to return the next scene enum when needed
     virtual void handleEvent(SDL_Event* event) = 0;
 
-    virtual void render() const = 0;
+    /**
+     * @brief Sends the resources loaded in the background to the renderer, within a small budget. Called on the render
+     * thread every frame, before render(), and also while the scene is being preloaded.
+     */
+    virtual void uploadTextures() = 0;
+
+    /**
+     * @brief Draws the scene.
+     * @param alpha How far into the current step to draw, from 0 (previous state) to 1 (current state).
+     */
+    virtual void render(float alpha) const = 0;
 
-  protected:
-    const std::shared_ptr<const PF::TextureManager> m_textureManager;
+    /**
+     * @brief Checks whether every resource the scene asked for is ready to draw, so switching to it shows no
+     * placeholder.
+     */
+    [[nodiscard]] virtual bool isLoaded() const = 0;
 };
 }  // namespace PF
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "Exceptions.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "SceneManager.h"
+
+PF::SceneManager::~SceneManager() { clear(); }
+
+void PF::SceneManager::push(std::unique_ptr<PF::Scene> scene) { m_stack.push_back(std::move(scene)); }
+
+void PF::SceneManager::pop()
+{
+    if (m_stack.empty()) { return; }
+    m_retired.push_back(std::move(m_stack.back()));
+    m_stack.pop_back();
+}
+
+void PF::SceneManager::preload(Factory factory)
+{
+    if (isPreloading()) { throw PF::Exception("A scene is already being preloaded."); }
+    m_building = std::async(std::launch::async, std::move(factory));
+    PF_LOG_INFO("Preloading the next scene in the background.");
+}
+
+bool PF::SceneManager::isPreloading() const { return m_building.valid() || m_preloaded != nullptr; }
+
+bool PF::SceneManager::isPreloadReady() const { return m_preloaded != nullptr && m_preloaded->isLoaded(); }
+
+PF::Scene& PF::SceneManager::switchToPreloaded()
+{
+    if (!isPreloadReady()) { throw PF::Exception("No preloaded scene is ready to switch to."); }
+
+    if (m_stack.empty()) { m_stack.push_back(std::move(m_preloaded)); }
+    else
+    {
+        m_retired.push_back(std::exchange(m_stack.back(), std::move(m_preloaded)));
+    }
+    PF_LOG_INFO("Switched to the preloaded scene.");
+    return *m_stack.back();
+}
+
+void PF::SceneManager::releaseRetired()
+{
+    if (m_retired.empty()) { return; }
+    PF_PROFILE_ZONE("SceneManager::releaseRetired");
+    m_retired.clear();
+}
+
+void PF::SceneManager::clear()
+{
+    if (m_building.valid()) { m_building.wait(); }
+    m_building = {};
+    m_preloaded.reset();
+    while (!m_stack.empty()) { m_stack.pop_back(); }
+    m_retired.clear();
+}
+
+PF::Scene* PF::SceneManager::getActive() const { return m_stack.empty() ? nullptr : m_stack.back().get(); }
+
+void PF::SceneManager::handleEvent(SDL_Event* event)
+{
+    if (!m_stack.empty()) { m_stack.back()->handleEvent(event); }
+}
+
+void PF::SceneManager::uploadTextures()
+{
+    if (!m_stack.empty()) { m_stack.back()->uploadTextures(); }
+
+    if (m_building.valid() && m_building.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+    {
+        m_preloaded = m_building.get();
+        PF_LOG_INFO("Preloaded scene built, uploading its textures.");
+    }
+    if (m_preloaded) { m_preloaded->uploadTextures(); }
+}
+
+void PF::SceneManager::render(float alpha) const
+{
+    for (const auto& scene : m_stack) { scene->render(alpha); }
+}
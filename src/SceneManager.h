@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "Scene.h"
+
+namespace PF
+{
+/**
+ * @class SceneManager
+ * @brief Keeps a stack of scenes, and builds the next one in the background while the current one keeps running.
+ *
+ * The manager routes events, texture uploads and drawing, and never steps a scene: main.cpp points the simulation
+ * thread at the active game. Only the top scene receives events; the whole stack is drawn, bottom to top, so a scene
+ * pushed over another is drawn over it. preload() runs a scene's constructor, asset registration and decoding
+ * included, on a background thread. Its images are then uploaded a few at a time between frames, and once
+ * isPreloadReady() says so, switchToPreloaded() replaces the top scene by swapping a pointer. The scene it replaces is
+ * destroyed by releaseRetired(), after the frame was presented, so the switch itself never waits for threads or
+ * textures.
+ */
+class SceneManager
+{
+  public:
+    using Factory = std::function<std::unique_ptr<PF::Scene>()>;
+
+    SceneManager() = default;
+
+    SceneManager(const SceneManager&) = delete;
+    SceneManager& operator=(const SceneManager&) = delete;
+    SceneManager(SceneManager&&) = delete;
+    SceneManager& operator=(SceneManager&&) = delete;
+
+    /**
+     * @brief Waits for the scene being preloaded, if any, then destroys every scene from the top down.
+     */
+    ~SceneManager();
+
+    /**
+     * @brief Makes `scene` the top scene. The one below stops receiving events until it is on top again.
+     */
+    void push(std::unique_ptr<PF::Scene> scene);
+
+    /**
+     * @brief Removes the top scene. It is destroyed by the next releaseRetired().
+     */
+    void pop();
+
+    /**
+     * @brief Starts building a scene on a background thread. The factory must not touch the renderer.
+     * @throws PF::Exception if another scene is already being preloaded.
+     */
+    void preload(Factory factory);
+
+    /**
+     * @brief Checks whether a scene is being preloaded, built or not.
+     */
+    [[nodiscard]] bool isPreloading() const;
+
+    /**
+     * @brief Checks whether the preloaded scene is built and has all its resources uploaded.
+     */
+    [[nodiscard]] bool isPreloadReady() const;
+
+    /**
+     * @brief Replaces the top scene by the preloaded one, or pushes it if the stack is empty. Constant time.
+     * @return The new top scene.
+     * @throws PF::Exception if isPreloadReady() is false.
+     */
+    PF::Scene& switchToPreloaded();
+
+    /**
+     * @brief Destroys the scenes replaced or popped since the last call. Call once the frame was presented.
+     */
+    void releaseRetired();
+
+    /**
+     * @brief Destroys every scene, including the one being preloaded. Call before the renderer goes away.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the top scene, or nullptr if the stack is empty.
+     */
+    [[nodiscard]] PF::Scene* getActive() const;
+
+    void handleEvent(SDL_Event* event);
+
+    /**
+     * @brief Uploads the images of the top scene, then collects the preloaded scene if its construction finished and
+     * uploads its images too. Rethrows whatever the preloaded scene's factory threw.
+     */
+    void uploadTextures();
+
+    void render(float alpha) const;
+
+  private:
+    std::vector<std::unique_ptr<PF::Scene>> m_stack;     // Scenes from bottom to top
+    std::vector<std::unique_ptr<PF::Scene>> m_retired;   // Scenes that left the stack, destroyed after presenting
+    std::unique_ptr<PF::Scene> m_preloaded;              // Built in the background, uploading its images
+    std::future<std::unique_ptr<PF::Scene>> m_building;  // Scene under construction, declared last to be waited first
+};
+}  // namespace PF
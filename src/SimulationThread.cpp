@@ -0,0 +1,62 @@
+#include <cstddef>
+#include <exception>
+#include <stop_token>
+#include <thread>
+
+#include "Game.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "SimulationThread.h"
+
+PF::SimulationThread::SimulationThread(PF::Game& game, PF::FixedTimestep timestep)
+    : m_game(game), m_timestep(timestep), m_thread([this](std::stop_token stopToken) { run(stopToken); })
+{
+}
+
+PF::SimulationThread::~SimulationThread() { stop(); }
+
+void PF::SimulationThread::stop()
+{
+    if (!m_thread.joinable()) { return; }
+    m_thread.request_stop();
+    m_thread.join();
+}
+
+void PF::SimulationThread::rethrowFailure() const
+{
+    if (m_failed.load(std::memory_order_acquire)) { std::rethrow_exception(m_failure); }
+}
+
+Uint64 PF::SimulationThread::getDroppedStepCount() const { return m_droppedStepCount.load(std::memory_order_relaxed); }
+
+void PF::SimulationThread::run(const std::stop_token& stopToken)
+{
+    const Uint64 stepMs = m_timestep.getStepNs() / SDL_NS_PER_MS;
+    m_timestep.reset(SDL_GetTicksNS());
+    try
+    {
+        while (!stopToken.stop_requested())
+        {
+            // Run as many constant steps as the elapsed time covers, bounded so a hitch cannot snowball
+            const std::size_t steps = m_timestep.advance(SDL_GetTicksNS());
+            if (steps > 0)
+            {
+                PF_PROFILE_ZONE("Simulation");
+                for (std::size_t step = 0; step < steps; ++step) { m_game.update(stepMs); }
+                m_game.publishSnapshot(m_timestep.getStateTimeNs());
+                m_droppedStepCount.store(m_timestep.getDroppedStepCount(), std::memory_order_relaxed);
+            }
+
+            // Nothing to do until the next step is due
+            const Uint64 nextStepNs = m_timestep.getStateTimeNs() + m_timestep.getStepNs();
+            const Uint64 nowNs = SDL_GetTicksNS();
+            if (nextStepNs > nowNs) { SDL_DelayPrecise(nextStepNs - nowNs); }
+        }
+    }
+    catch (...)
+    {
+        PF_LOG_CRITICAL("The simulation thread stopped on an exception.");
+        m_failure = std::current_exception();
+        m_failed.store(true, std::memory_order_release);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <exception>
+#include <stop_token>
+#include <thread>
+
+#include "FixedTimestep.h"
+
+namespace PF
+{
+class Game;
+
+/**
+ * @class SimulationThread
+ * @brief Steps a game at a fixed rate on a thread of its own, so simulating and drawing overlap.
+ *
+ * After every batch of steps the game publishes a render snapshot, which the render thread draws while the next
+ * steps run. A slow frame or present therefore no longer delays simulation ticks, and frame time is the larger of the
+ * two rather than their sum. The thread sleeps until the next step is due.
+ */
+class SimulationThread
+{
+  public:
+    /**
+     * @brief Starts stepping `game`. Until stop(), nothing else may call its update().
+     * @param timestep The step duration and catch-up limit. Its clock restarts now.
+     */
+    SimulationThread(PF::Game& game, PF::FixedTimestep timestep);
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    SimulationThread(SimulationThread&&) = delete;
+    SimulationThread& operator=(SimulationThread&&) = delete;
+
+    ~SimulationThread();
+
+    /**
+     * @brief Waits for the current batch of steps to end and stops the thread. The game is then free to use.
+     */
+    void stop();
+
+    /**
+     * @brief Rethrows, on the calling thread, the exception that ended the simulation thread, if any.
+     */
+    void rethrowFailure() const;
+
+    /**
+     * @brief Gets the number of steps skipped so far because the simulation fell too far behind.
+     */
+    [[nodiscard]] Uint64 getDroppedStepCount() const;
+
+  private:
+    void run(const std::stop_token& stopToken);  // Body of the thread
+
+  private:
+    PF::Game& m_game;
+    PF::FixedTimestep m_timestep;               // Simulation thread only
+    std::atomic<Uint64> m_droppedStepCount{0};  // Copy of the timestep's count, for the other threads
+    std::exception_ptr m_failure;               // Written by the thread before it sets m_failed
+    std::atomic<bool> m_failed{false};
+    std::jthread m_thread;  // Declared last: it starts once everything else exists
+};
+}  // namespace PF
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "EntityColumns.h"
+#include "EntityStore.h"
+#include "ParticleSystem.h"
+#include "SpatialHash.h"
+
+constexpr std::size_t MIN_BUCKET_COUNT = 64;
+constexpr std::size_t BUCKETS_PER_ENTRY = 2;     // Keeps most buckets down to a single cell
+constexpr std::size_t MAX_CELLS_PER_ENTITY = 4;  // An entity no larger than a cell straddles at most two by two cells
+constexpr std::uint32_t HASH_PRIME_X = 73856093U;
+constexpr std::uint32_t HASH_PRIME_Y = 19349663U;
+
+PF::SpatialHash::SpatialHash(float cellSize): m_cellSize(cellSize), m_inverseCellSize(1.0F / cellSize)
+{
+    assert(cellSize > 0.0F && "Cell size must be greater than zero.");
+}
+
+void PF::SpatialHash::rebuild(const PF::EntityStore& entities)
+{
+    beginBuild();
+    entities.forEachKind([&](const auto& store) { insert(store.KIND, store.getColumns()); });
+    insert(entities.getParticles());
+    finishBuild();
+}
+
+void PF::SpatialHash::reserve(std::size_t entities)
+{
+    const std::size_t entries = entities * MAX_CELLS_PER_ENTITY;
+    m_pending.reserve(entries);
+    m_entries.reserve(entries);
+    m_bucketStart.reserve(std::bit_ceil(std::max(MIN_BUCKET_COUNT, entries * BUCKETS_PER_ENTRY)) + 1);
+}
+
+void PF::SpatialHash::beginBuild() { m_pending.clear(); }
+
+void PF::SpatialHash::insert(PF::EntityKind kind, const PF::EntityColumns& columns)
+{
+    const std::size_t count = columns.count();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        insertBounds({.kind = kind, .index = static_cast<std::uint32_t>(i)}, columns.dstRect(i));
+    }
+}
+
+void PF::SpatialHash::insert(const PF::ParticleSystem& particles)
+{
+    for (std::size_t e = 0; e < particles.getEmitterCount(); ++e)
+    {
+        const PF::ParticleEmitter& emitter = particles.getEmitter(e);
+        for (std::size_t age = 0; age < emitter.count(); ++age)
+        {
+            const std::size_t slot = emitter.getSlot(age);
+            insertBounds({.kind = PF::EntityKind::PARTICLE,
+                          .index = static_cast<std::uint32_t>(slot),
+                          .emitter = static_cast<std::uint32_t>(e)},
+                         emitter.getBounds(slot));
+        }
+    }
+}
+
+void PF::SpatialHash::finishBuild()
+{
+    const std::size_t bucketCount = std::bit_ceil(std::max(MIN_BUCKET_COUNT, m_pending.size() * BUCKETS_PER_ENTRY));
+    m_bucketMask = bucketCount - 1;
+
+    // Counting sort by bucket: count, prefix sum, then scatter
+    m_bucketStart.assign(bucketCount + 1, 0);
+    for (const Entry& entry : m_pending) { ++m_bucketStart[bucketOf(entry.cellX, entry.cellY) + 1]; }
+    for (std::size_t b = 0; b < bucketCount; ++b) { m_bucketStart[b + 1] += m_bucketStart[b]; }
+
+    // Each bucket start doubles as its write cursor, leaving it at the start of the next bucket, hence the shift back
+    m_entries.resize(m_pending.size());
+    for (const Entry& entry : m_pending) { m_entries[m_bucketStart[bucketOf(entry.cellX, entry.cellY)]++] = entry; }
+    for (std::size_t b = bucketCount; b > 0; --b) { m_bucketStart[b] = m_bucketStart[b - 1]; }
+    m_bucketStart[0] = 0;
+}
+
+void PF::SpatialHash::insertBounds(PF::EntityRef entity, const SDL_FRect& bounds)
+{
+    const CellRange range = toCellRange(bounds);
+    for (std::int32_t cellY = range.minY; cellY <= range.maxY; ++cellY)
+    {
+        for (std::int32_t cellX = range.minX; cellX <= range.maxX; ++cellX)
+        {
+            m_pending.push_back({entity, bounds, cellX, cellY});
+        }
+    }
+}
+
+float PF::SpatialHash::getCellSize() const { return m_cellSize; }
+
+std::size_t PF::SpatialHash::getEntryCount() const { return m_entries.size(); }
+
+std::int32_t PF::SpatialHash::toCell(float coordinate) const
+{
+    return static_cast<std::int32_t>(std::floor(coordinate * m_inverseCellSize));
+}
+
+PF::SpatialHash::CellRange PF::SpatialHash::toCellRange(const SDL_FRect& bounds) const
+{
+    return {toCell(bounds.x), toCell(bounds.y), toCell(bounds.x + bounds.w), toCell(bounds.y + bounds.h)};
+}
+
+std::size_t PF::SpatialHash::bucketOf(std::int32_t cellX, std::int32_t cellY) const
+{
+    const std::uint32_t hash =
+        (static_cast<std::uint32_t>(cellX) * HASH_PRIME_X) ^ (static_cast<std::uint32_t>(cellY) * HASH_PRIME_Y);
+    return hash & m_bucketMask;
+}
+
+bool PF::SpatialHash::isReferenceCell(
+    const SDL_FRect& a, const SDL_FRect& b, std::int32_t cellX, std::int32_t cellY) const
+{
+    return toCell(std::max(a.x, b.x)) == cellX && toCell(std::max(a.y, b.y)) == cellY;
+}
+
+bool PF::SpatialHash::overlaps(const SDL_FRect& a, const SDL_FRect& b)
+{
+    return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Enums.h"
+
+namespace PF
+{
+struct EntityColumns;
+class EntityStore;
+class ParticleSystem;
+
+/**
+ * @struct EntityRef
+ * @brief Identifies an entity by kind and index in its store, or a particle by emitter and slot. Only valid until the
+ * store changes.
+ */
+struct EntityRef
+{
+    PF::EntityKind kind = PF::EntityKind::EntityKind_Last;
+    std::uint32_t index = 0;    // Slot in the emitter for particles
+    std::uint32_t emitter = 0;  // Emitter holding the particle, see ParticleSystem::getEmitter(). Zero for entities.
+};
+
+/**
+ * @class SpatialHash
+ * @brief Uniform-grid broad phase answering "which entities are near here" without scanning every entity.
+ *
+ * The world is cut in square cells, and every entity is filed under each cell its bounding box overlaps. Cells are
+ * hashed into a flat bucket array that is rebuilt from the entity columns with a counting sort, so rebuilding costs
+ * O(N) and does not allocate once the arrays have grown. A query only looks at the cells it overlaps, so its cost
+ * depends on the local density rather than on the number of entities in the world.
+ *
+ * Every query reports each matching entity exactly once, even when it spans several cells.
+ */
+class SpatialHash
+{
+  public:
+    static constexpr float DEFAULT_CELL_SIZE = 64.0F;
+
+    /**
+     * @param cellSize The side of a grid cell, in pixels. Works best around the size of the largest common entity.
+     */
+    explicit SpatialHash(float cellSize = DEFAULT_CELL_SIZE);
+
+    /**
+     * @brief Re-indexes every entity and particle of the store from its current position and size.
+     */
+    void rebuild(const PF::EntityStore& entities);
+
+    /**
+     * @brief Sizes the index for `entities` entities no larger than a cell, so that rebuilding never allocates while
+     * the population stays below that.
+     */
+    void reserve(std::size_t entities);
+
+    /**
+     * @brief Starts an incremental build, dropping the previous index.
+     */
+    void beginBuild();
+
+    /**
+     * @brief Adds every entity of one kind to the build started by beginBuild().
+     */
+    void insert(PF::EntityKind kind, const PF::EntityColumns& columns);
+
+    /**
+     * @brief Adds every particle of every emitter to the build started by beginBuild(), as PARTICLE entities.
+     */
+    void insert(const PF::ParticleSystem& particles);
+
+    /**
+     * @brief Finishes the build. Queries are only valid after this call.
+     */
+    void finishBuild();
+
+    /**
+     * @brief Calls `visitor(EntityRef, const SDL_FRect& bounds)` for every entity whose bounds overlap `area`.
+     */
+    template<typename Visitor>
+    void queryAABB(const SDL_FRect& area, Visitor&& visitor) const;
+
+    /**
+     * @brief Calls `visitor(EntityRef, const SDL_FRect& bounds)` for every entity whose bounds overlap the circle.
+     */
+    template<typename Visitor>
+    void queryRadius(SDL_FPoint centre, float radius, Visitor&& visitor) const;
+
+    /**
+     * @brief Calls `visitor(EntityRef, EntityRef)` once for every pair of entities with overlapping bounds.
+     */
+    template<typename Visitor>
+    void forEachPair(Visitor&& visitor) const;
+
+    [[nodiscard]] float getCellSize() const;
+
+    /**
+     * @brief Gets the number of cell entries, which grows when entities straddle cell borders.
+     */
+    [[nodiscard]] std::size_t getEntryCount() const;
+
+  private:
+    struct Entry
+    {
+        PF::EntityRef entity;
+        SDL_FRect bounds;
+        std::int32_t cellX;  // Cell the entry was filed under, to tell apart cells sharing a bucket
+        std::int32_t cellY;
+    };
+
+    struct CellRange
+    {
+        std::int32_t minX;
+        std::int32_t minY;
+        std::int32_t maxX;
+        std::int32_t maxY;
+    };
+
+    /**
+     * @brief Files `entity` under every cell `bounds` overlaps.
+     */
+    void insertBounds(PF::EntityRef entity, const SDL_FRect& bounds);
+
+    [[nodiscard]] std::int32_t toCell(float coordinate) const;
+    [[nodiscard]] CellRange toCellRange(const SDL_FRect& bounds) const;
+    [[nodiscard]] std::size_t bucketOf(std::int32_t cellX, std::int32_t cellY) const;
+
+    // The cell holding the top-left corner of the overlap of two boxes. Reporting a match only from that cell is what
+    // keeps boxes that share several cells from being reported several times.
+    [[nodiscard]] bool isReferenceCell(
+        const SDL_FRect& a, const SDL_FRect& b, std::int32_t cellX, std::int32_t cellY) const;
+
+    [[nodiscard]] static bool overlaps(const SDL_FRect& a, const SDL_FRect& b);
+
+  private:
+    float m_cellSize;
+    float m_inverseCellSize;
+    std::size_t m_bucketMask = 0;
+    std::vector<Entry> m_pending;            // Entries gathered by insert(), in insertion order
+    std::vector<Entry> m_entries;            // Entries sorted by bucket
+    std::vector<std::size_t> m_bucketStart;  // Bucket b holds m_entries[m_bucketStart[b], m_bucketStart[b + 1])
+};
+
+template<typename Visitor>
+void SpatialHash::queryAABB(const SDL_FRect& area, Visitor&& visitor) const
+{
+    if (m_entries.empty()) { return; }
+
+    const CellRange range = toCellRange(area);
+    for (std::int32_t cellY = range.minY; cellY <= range.maxY; ++cellY)
+    {
+        for (std::int32_t cellX = range.minX; cellX <= range.maxX; ++cellX)
+        {
+            const std::size_t bucket = bucketOf(cellX, cellY);
+            for (std::size_t e = m_bucketStart[bucket]; e < m_bucketStart[bucket + 1]; ++e)
+            {
+                const Entry& entry = m_entries[e];
+                if (entry.cellX != cellX || entry.cellY != cellY) { continue; }
+                if (!overlaps(entry.bounds, area) || !isReferenceCell(entry.bounds, area, cellX, cellY)) { continue; }
+                visitor(entry.entity, entry.bounds);
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+void SpatialHash::queryRadius(SDL_FPoint centre, float radius, Visitor&& visitor) const
+{
+    const SDL_FRect area = {centre.x - radius, centre.y - radius, radius * 2, radius * 2};
+    const float radiusSquared = radius * radius;
+    queryAABB(area,
+              [&](const PF::EntityRef entity, const SDL_FRect& bounds)
+              {
+                  // Distance from the centre to the closest point of the box
+                  const float dx = centre.x - std::fmax(bounds.x, std::fmin(centre.x, bounds.x + bounds.w));
+                  const float dy = centre.y - std::fmax(bounds.y, std::fmin(centre.y, bounds.y + bounds.h));
+                  if ((dx * dx) + (dy * dy) <= radiusSquared) { visitor(entity, bounds); }
+              });
+}
+
+template<typename Visitor>
+void SpatialHash::forEachPair(Visitor&& visitor) const
+{
+    const std::size_t bucketCount = m_bucketStart.empty() ? 0 : m_bucketStart.size() - 1;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        const std::size_t end = m_bucketStart[bucket + 1];
+        for (std::size_t a = m_bucketStart[bucket]; a < end; ++a)
+        {
+            const Entry& first = m_entries[a];
+            for (std::size_t b = a + 1; b < end; ++b)
+            {
+                const Entry& second = m_entries[b];
+                if (first.cellX != second.cellX || first.cellY != second.cellY) { continue; }
+                if (!overlaps(first.bounds, second.bounds)) { continue; }
+                if (!isReferenceCell(first.bounds, second.bounds, first.cellX, first.cellY)) { continue; }
+                visitor(first.entity, second.entity);
+            }
+        }
+    }
+}
+}  // namespace PF
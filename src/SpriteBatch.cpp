@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <numbers>
+
+#include "AnimationCurve.h"
+#include "Exceptions.h"
+#include "SpriteBatch.h"
+
+constexpr float DEGREES_TO_RADIANS = std::numbers::pi_v<float> / 180.0F;
+constexpr SDL_FColor WHITE = {1.0F, 1.0F, 1.0F, SDL_ALPHA_OPAQUE_FLOAT};
+
+void PF::SpriteBatch::begin()
+{
+    for (std::size_t i = 0; i < m_activeCount; ++i)
+    {
+        m_batches[i].vertices.clear();
+        m_batches[i].indices.clear();
+    }
+    m_activeCount = 0;
+}
+
+PF::SpriteBatch::Batch& PF::SpriteBatch::getBatch(SDL_Texture* texture)
+{
+    // Only a handful of textures are in use per frame, so a linear search beats hashing here
+    for (std::size_t i = 0; i < m_activeCount; ++i)
+    {
+        if (m_batches[i].texture == texture) { return m_batches[i]; }
+    }
+
+    if (m_activeCount == m_batches.size()) { m_batches.emplace_back(); }
+    Batch& batch = m_batches[m_activeCount++];
+    batch.texture = texture;
+
+    float width = 0.0F;
+    float height = 0.0F;
+    if (!SDL_GetTextureSize(texture, &width, &height)) { throw PF::SDLException("Failed to query texture size"); }
+    batch.inverseWidth = 1.0F / width;
+    batch.inverseHeight = 1.0F / height;
+    return batch;
+}
+
+void PF::SpriteBatch::draw(SDL_Texture* texture, const SDL_FRect& srcRect, const SDL_FRect& dstRect, float angle)
+{
+    Batch& batch = getBatch(texture);
+
+    // Corners relative to the centre of the destination, clockwise from the top-left
+    const float halfWidth = dstRect.w / 2;
+    const float halfHeight = dstRect.h / 2;
+    const SDL_FPoint centre = {dstRect.x + halfWidth, dstRect.y + halfHeight};
+    const SDL_FPoint corners[4] = {
+        {-halfWidth, -halfHeight},
+        { halfWidth, -halfHeight},
+        { halfWidth,  halfHeight},
+        {-halfWidth,  halfHeight}
+    };
+
+    const float u0 = srcRect.x * batch.inverseWidth;
+    const float v0 = srcRect.y * batch.inverseHeight;
+    const float u1 = (srcRect.x + srcRect.w) * batch.inverseWidth;
+    const float v1 = (srcRect.y + srcRect.h) * batch.inverseHeight;
+    const SDL_FPoint texCoords[4] = {
+        {u0, v0},
+        {u1, v0},
+        {u1, v1},
+        {u0, v1}
+    };
+
+    // Same rotation as SDL_RenderTextureRotated: clockwise around the centre, with y pointing down
+    const float radians = angle * DEGREES_TO_RADIANS;
+    const float cosAngle = angle == 0.0F ? 1.0F : PF::Animation::cos(radians);
+    const float sinAngle = angle == 0.0F ? 0.0F : PF::Animation::sin(radians);
+
+    const int base = static_cast<int>(batch.vertices.size());
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const SDL_FPoint position = {centre.x + (corners[i].x * cosAngle) - (corners[i].y * sinAngle),
+                                     centre.y + (corners[i].x * sinAngle) + (corners[i].y * cosAngle)};
+        batch.vertices.push_back({position, WHITE, texCoords[i]});
+    }
+
+    // Two triangles per quad
+    for (const int index : {0, 1, 2, 2, 3, 0}) { batch.indices.push_back(base + index); }
+}
+
+void PF::SpriteBatch::flush(SDL_Renderer* renderer)
+{
+    m_drawCallCount = 0;
+    m_quadCount = 0;
+    for (std::size_t i = 0; i < m_activeCount; ++i)
+    {
+        const Batch& batch = m_batches[i];
+        if (batch.indices.empty()) { continue; }
+
+        const bool success = SDL_RenderGeometry(renderer,
+                                                batch.texture,
+                                                batch.vertices.data(),
+                                                static_cast<int>(batch.vertices.size()),
+                                                batch.indices.data(),
+                                                static_cast<int>(batch.indices.size()));
+        if (!success) { throw PF::SDLException("Failed to render sprite batch"); }
+
+        ++m_drawCallCount;
+        m_quadCount += batch.vertices.size() / 4;
+    }
+    begin();
+}
+
+std::size_t PF::SpriteBatch::getDrawCallCount() const { return m_drawCallCount; }
+
+std::size_t PF::SpriteBatch::getQuadCount() const { return m_quadCount; }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace PF
+{
+/**
+ * @class SpriteBatch
+ * @brief Collects every textured quad of a frame and submits them grouped by texture.
+ *
+ * Sprites are accumulated between begin() and flush(). Each texture gets its own vertex/index buffer, and flush()
+ * submits every buffer with a single SDL_RenderGeometry call, so the number of draw calls follows the number of
+ * textures in use rather than the number of sprites.
+ *
+ * Quads sharing a texture keep their submission order. Quads using different textures are drawn texture by texture,
+ * in the order each texture was first used during the frame.
+ *
+ * The buffers are cleared but not released between frames, so a steady-state frame does not allocate.
+ */
+class SpriteBatch
+{
+  public:
+    /**
+     * @brief Starts a new frame, discarding any quad that was not flushed.
+     */
+    void begin();
+
+    /**
+     * @brief Queues a textured quad.
+     * @param texture The texture to sample from.
+     * @param srcRect The source rectangle inside the texture, in pixels.
+     * @param dstRect The destination rectangle on screen, in pixels.
+     * @param angle Clockwise rotation around the centre of dstRect, in degrees.
+     */
+    void draw(SDL_Texture* texture, const SDL_FRect& srcRect, const SDL_FRect& dstRect, float angle = 0.0F);
+
+    /**
+     * @brief Submits every queued quad, one SDL_RenderGeometry call per texture.
+     * @param renderer The renderer to draw with.
+     * @throws PF::SDLException if a submission fails.
+     */
+    void flush(SDL_Renderer* renderer);
+
+    /**
+     * @brief Gets the number of SDL_RenderGeometry calls issued by the last flush.
+     */
+    [[nodiscard]] std::size_t getDrawCallCount() const;
+
+    /**
+     * @brief Gets the number of quads submitted by the last flush.
+     */
+    [[nodiscard]] std::size_t getQuadCount() const;
+
+  private:
+    struct Batch
+    {
+        SDL_Texture* texture = nullptr;
+        float inverseWidth = 1.0F;   // 1 / texture width, to normalize texture coordinates
+        float inverseHeight = 1.0F;  // 1 / texture height, to normalize texture coordinates
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    Batch& getBatch(SDL_Texture* texture);
+
+  private:
+    std::vector<Batch> m_batches;   // One batch per texture, reused across frames
+    std::size_t m_activeCount = 0;  // Number of batches used this frame
+    std::size_t m_drawCallCount = 0;
+    std::size_t m_quadCount = 0;
+};
+}  // namespace PF
@@ -1,26 +1,54 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <exception>
 #include <filesystem>
 #include <format>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #include "Exceptions.h"
+#include "Log.h"
 #include "TextureManager.h"
 
-PF::Texture::Texture(SDL_Renderer* renderer, std::string_view filePath)
+PF::Texture::Texture(SDL_Renderer* renderer, int width, int height)
 {
-    std::filesystem::path canonicalPath = std::filesystem::canonical(filePath);
-    SDL_Surface* fileSurface = IMG_Load(canonicalPath.string().c_str());
-    if (fileSurface == nullptr) { throw PF::SDLException(std::format("Couldn't load image file: {}", filePath)); }
+    // Owned here until fully set up: the destructor does not run if the constructor throws
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture(
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height),
+        SDL_DestroyTexture);
+    if (texture == nullptr) { throw PF::SDLException(std::format("Couldn't create {}x{} texture", width, height)); }
+    if (!SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND))
+    {
+        throw PF::SDLException("Couldn't enable blending on texture");
+    }
 
-    m_texture = SDL_CreateTextureFromSurface(renderer, fileSurface);
-    if (m_texture == nullptr)
+    // Static textures start with undefined content, and the gaps between images must stay transparent
+    const std::vector<Uint32> transparent(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0);
+    if (!SDL_UpdateTexture(texture.get(), nullptr, transparent.data(), width * static_cast<int>(sizeof(Uint32))))
     {
-        throw PF::SDLException(std::format("Couldn't create texture from surface: {}", filePath));
+        throw PF::SDLException("Couldn't clear texture");
+    }
+    m_texture = texture.release();
+}
+
+void PF::Texture::update(const SDL_Rect& area, const void* pixels, int pitch) const
+{
+    if (!SDL_UpdateTexture(m_texture, &area, pixels, pitch))
+    {
+        throw PF::SDLException("Couldn't upload surface to texture");
     }
-    SDL_DestroySurface(fileSurface);  // done with this, the texture has a copy of the pixels now.
 }
 
 SDL_Texture& PF::Texture::get() const
@@ -33,17 +61,636 @@ SDL_Texture& PF::Texture::operator->() const { return get(); }
 
 SDL_Texture& PF::Texture::operator*() const { return get(); }
 
-PF::TextureManager::TextureManager(SDL_Renderer* renderer): m_renderer(renderer) {}
+bool PF::Texture::isCreated() const { return m_texture != nullptr; }
+
+PF::Texture::Texture(Texture&& other) noexcept: m_texture(std::exchange(other.m_texture, nullptr)) {}
+
+PF::Texture& PF::Texture::operator=(Texture&& other) noexcept
+{
+    if (this != &other)
+    {
+        SDL_DestroyTexture(m_texture);
+        m_texture = std::exchange(other.m_texture, nullptr);
+    }
+    return *this;
+}
+
+PF::Texture::~Texture() { SDL_DestroyTexture(m_texture); }
+
+PF::TextureHandle::TextureHandle(PF::TextureManager* manager, std::size_t index): m_manager(manager), m_index(index)
+{
+    m_manager->retain(m_index);
+}
+
+PF::TextureHandle::TextureHandle(const TextureHandle& other): m_manager(other.m_manager), m_index(other.m_index)
+{
+    if (m_manager != nullptr) { m_manager->retain(m_index); }
+}
+
+PF::TextureHandle& PF::TextureHandle::operator=(const TextureHandle& other)
+{
+    TextureHandle copy(other);
+    *this = std::move(copy);
+    return *this;
+}
+
+PF::TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+    : m_manager(std::exchange(other.m_manager, nullptr)), m_index(other.m_index)
+{
+}
+
+PF::TextureHandle& PF::TextureHandle::operator=(TextureHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        m_manager = std::exchange(other.m_manager, nullptr);
+        m_index = other.m_index;
+    }
+    return *this;
+}
+
+PF::TextureHandle::~TextureHandle() { reset(); }
+
+std::size_t PF::TextureHandle::get() const
+{
+    assert(m_manager && "Empty texture handle.");
+    return m_index;
+}
+
+void PF::TextureHandle::reset()
+{
+    if (m_manager == nullptr) { return; }
+    m_manager->release(m_index);
+    m_manager = nullptr;
+}
+
+PF::TextureHandle::operator bool() const { return m_manager != nullptr; }
+
+namespace
+{
+constexpr int PLACEHOLDER_SIZE = 8;
+constexpr Uint8 PLACEHOLDER_GREY = 0x80;
+
+std::size_t PageBytes(int width, int height)
+{
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * sizeof(Uint32);  // RGBA32
+}
+
+/**
+ * @brief Reads and decodes an image file into RGBA32 pixels, the format of the atlas pages. Safe on any thread.
+ * @throws PF::SDLException if the file cannot be loaded or converted.
+ * @throws std::filesystem::filesystem_error if the path does not resolve.
+ */
+SDL_Surface* DecodeImage(std::string_view filePath)
+{
+    std::filesystem::path canonicalPath = std::filesystem::canonical(filePath);
+    SDL_Surface* fileSurface = IMG_Load(canonicalPath.string().c_str());
+    if (fileSurface == nullptr) { throw PF::SDLException(std::format("Couldn't load image file: {}", filePath)); }
+
+    SDL_Surface* surface = SDL_ConvertSurface(fileSurface, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(fileSurface);
+    if (surface == nullptr) { throw PF::SDLException(std::format("Couldn't convert image file: {}", filePath)); }
+    return surface;
+}
+
+/**
+ * @brief Shrinks RGBA32 pixels to half their size, averaging each 2x2 block weighted by alpha, so transparent pixels
+ * do not darken the edges. Odd sides round down, repeating their last row or column. Safe on any thread.
+ * @throws PF::SDLException if the surface cannot be created.
+ */
+SDL_Surface* HalveImage(int width, int height, const void* pixels, int pitch)
+{
+    const int halfWidth = std::max(width / 2, 1);
+    const int halfHeight = std::max(height / 2, 1);
+    SDL_Surface* half = SDL_CreateSurface(halfWidth, halfHeight, SDL_PIXELFORMAT_RGBA32);
+    if (half == nullptr) { throw PF::SDLException(std::format("Couldn't create {}x{} mipmap", halfWidth, halfHeight)); }
+
+    const auto* source = static_cast<const Uint8*>(pixels);
+    auto* destination = static_cast<Uint8*>(half->pixels);
+    for (int y = 0; y < halfHeight; ++y)
+    {
+        const std::array<int, 2> rowIndices = {y * 2, std::min((y * 2) + 1, height - 1)};
+        const std::array<const Uint8*, 2> rows = {source + (static_cast<std::ptrdiff_t>(rowIndices[0]) * pitch),
+                                                  source + (static_cast<std::ptrdiff_t>(rowIndices[1]) * pitch)};
+        Uint8* out = destination + (static_cast<std::ptrdiff_t>(y) * half->pitch);
+        for (int x = 0; x < halfWidth; ++x)
+        {
+            const std::array<int, 2> columns = {x * 2 * 4, std::min((x * 2) + 1, width - 1) * 4};
+            std::array<Uint32, 4> sum{};  // Colour channels weighted by alpha, then alpha
+            for (const Uint8* row : rows)
+            {
+                for (const int column : columns)
+                {
+                    const Uint8* pixel = row + column;
+                    for (std::size_t channel = 0; channel < 3; ++channel) { sum[channel] += pixel[channel] * pixel[3]; }
+                    sum[3] += pixel[3];
+                }
+            }
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                out[channel] = sum[3] == 0 ? 0 : static_cast<Uint8>(sum[channel] / sum[3]);
+            }
+            out[3] = static_cast<Uint8>(sum[3] / 4);
+            out += 4;
+        }
+    }
+    return half;
+}
+}  // namespace
+
+PF::TextureManager::TextureManager(SDL_Renderer* renderer): m_renderer(renderer)
+{
+    if (isHeadless()) { return; }
+
+    // Some renderers cap the texture size below the default page size
+    const Sint64 maxTextureSize =
+        SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (maxTextureSize > 0) { m_pageSize = static_cast<int>(std::min<Sint64>(ATLAS_PAGE_SIZE, maxTextureSize)); }
+
+    // The placeholder is uploaded by the first uploadLoaded(), so a manager can be built away from the render thread
+}
+
+PF::TextureManager::~TextureManager()
+{
+    if (m_loader.joinable())
+    {
+        m_loader.request_stop();
+        m_loader.join();
+    }
+    for (LoadResult& result : m_results) { destroySurfaces(result); }
+}
+
+void PF::TextureManager::mountPack(std::string_view packPath)
+{
+    m_packs.emplace_back(packPath);
+    PF_LOG_INFO("Asset pack mounted: %s (%zu images)", packPath, m_packs.back().getImages().size());
+}
+
+PF::TextureHandle PF::TextureManager::addTexture(std::string_view filePath, const PF::TextureOptions& options)
+{
+    const auto [handle, cached] = findOrInsert(filePath, options);
+    TextureHandle texture(this, handle);
+    if (cached) { return texture; }
+
+    CachedImage& image = m_images[handle];
+    if (isHeadless())
+    {
+        // Nothing will ever be drawn, so keep the handle valid without touching the file
+        image.region = {};
+        image.residency = Residency::RESIDENT;
+        return texture;
+    }
+
+    // Packed levels are already in the atlas format: no file lookup, no decoding, no intermediate copy
+    image.residency = Residency::LOADING;  // An evicted image is loaded again into its old entry
+    try
+    {
+        LoadResult result = load(makeRequest(handle));
+        uploadLevels(result);
+    }
+    catch (...)
+    {
+        m_images[handle].residency = Residency::EVICTED;  // Asking for it again retries
+        throw;
+    }
+    return texture;
+}
+
+PF::TextureHandle PF::TextureManager::addTextureAsync(std::string_view filePath, const PF::TextureOptions& options)
+{
+    if (isHeadless()) { return addTexture(filePath, options); }
+
+    const auto [handle, cached] = findOrInsert(filePath, options);
+    TextureHandle texture(this, handle);
+    if (cached) { return texture; }
+
+    CachedImage& image = m_images[handle];
+    image.region = {.ready = false};
+    image.residency = Residency::LOADING;
+    ++m_pendingCount;
+
+    // Packed levels need no decoding, so unless mipmaps are to be generated, they only wait for the render thread
+    LoadRequest request = makeRequest(handle);
+    if (!request.generateMipmaps && std::ranges::find(request.packed, nullptr) == request.packed.end())
+    {
+        LoadResult result;
+        try
+        {
+            result = load(request);
+        }
+        catch (...)
+        {
+            --m_pendingCount;
+            image.residency = Residency::EVICTED;  // Asking for it again retries
+            throw;
+        }
+        const std::scoped_lock lock(m_loadMutex);
+        m_results.push_back(std::move(result));
+        return texture;
+    }
+
+    if (!m_loader.joinable())
+    {
+        m_loader = std::jthread([this](std::stop_token stopToken) { loadImages(std::move(stopToken)); });
+    }
+    {
+        const std::scoped_lock lock(m_loadMutex);
+        m_requests.push_back(std::move(request));
+    }
+    m_loadWake.notify_one();
+    return texture;
+}
+
+std::size_t PF::TextureManager::uploadLoaded(Uint64 budgetNs)
+{
+    if (!m_placeholderUploaded && !isHeadless())
+    {
+        // Plain grey square drawn in place of the images still loading
+        std::array<Uint8, PLACEHOLDER_SIZE * PLACEHOLDER_SIZE * 4> pixels{};
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            pixels[i] = pixels[i + 1] = pixels[i + 2] = PLACEHOLDER_GREY;
+            pixels[i + 3] = 0xFF;
+        }
+        m_placeholder = upload(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, pixels.data(), PLACEHOLDER_SIZE * 4);
+        m_placeholder.ready = false;
+        m_placeholderUploaded = true;
+    }
+
+    // Pages released since the budget was last exceeded
+    if (m_residentBytes > m_memoryBudget) { trimToBudget(0); }
+
+    const Uint64 start = SDL_GetTicksNS();
+    std::size_t uploaded = 0;
+    while (uploaded == 0 || SDL_GetTicksNS() - start < budgetNs)
+    {
+        LoadResult result;
+        {
+            const std::scoped_lock lock(m_loadMutex);
+            if (m_results.empty()) { break; }
+            result = std::move(m_results.front());
+            m_results.pop_front();
+        }
+        --m_pendingCount;
+        ++uploaded;
+
+        if (result.levels.empty())
+        {
+            m_images[result.handle].residency = Residency::EVICTED;  // Asking for it again retries
+            PF_LOG_WARNING("Couldn't load texture from file: %s (%s)", result.filePath, result.error);
+            continue;
+        }
+        uploadLevels(result);
+    }
+    return uploaded;
+}
+
+void PF::TextureManager::setMemoryBudget(std::size_t bytes) { m_memoryBudget = bytes; }
+
+std::size_t PF::TextureManager::getMemoryBudget() const { return m_memoryBudget; }
+
+PF::TextureCacheStats PF::TextureManager::getCacheStats() const
+{
+    PF::TextureCacheStats stats = m_stats;
+    stats.residentBytes = m_residentBytes;
+    stats.residentPages = static_cast<std::size_t>(std::ranges::count_if(m_pages, &Texture::isCreated));
+    stats.referencedImages = static_cast<std::size_t>(
+        std::ranges::count_if(m_images, [](const CachedImage& image) { return image.referenceCount > 0; }));
+    return stats;
+}
+
+std::size_t PF::TextureManager::getPendingCount() const { return m_pendingCount; }
+
+void PF::TextureManager::loadImages(std::stop_token stopToken)
+{
+    while (true)
+    {
+        LoadRequest request;
+        {
+            std::unique_lock lock(m_loadMutex);
+            if (!m_loadWake.wait(lock, stopToken, [this] { return !m_requests.empty(); })) { return; }
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        // Decode outside the lock, so the render thread never waits for a file
+        LoadResult result;
+        try
+        {
+            result = load(request);
+        }
+        catch (const std::exception& e)
+        {
+            result = {.handle = request.handle, .filePath = request.filePaths.front(), .levels = {}, .error = e.what()};
+        }
+
+        const std::scoped_lock lock(m_loadMutex);
+        m_results.push_back(std::move(result));
+    }
+}
+
+PF::TextureManager::LoadRequest PF::TextureManager::makeRequest(std::size_t handle) const
+{
+    const CachedImage& image = m_images[handle];
+    LoadRequest request{.handle = handle, .filePaths = {image.key}, .packed = {}, .generateMipmaps = false};
+    request.filePaths.insert(request.filePaths.end(), image.options.levelPaths.begin(), image.options.levelPaths.end());
+    request.generateMipmaps = image.options.generateMipmaps;
+    for (const std::string& filePath : request.filePaths) { request.packed.push_back(findPacked(filePath)); }
+    return request;
+}
+
+PF::TextureManager::LoadResult PF::TextureManager::load(const LoadRequest& request)
+{
+    LoadResult result{.handle = request.handle, .filePath = request.filePaths.front(), .levels = {}, .error = {}};
+    try
+    {
+        for (std::size_t i = 0; i < request.filePaths.size(); ++i)
+        {
+            if (const AssetPack::Image* packed = request.packed[i])
+            {
+                result.levels.push_back({.width = packed->width,
+                                         .height = packed->height,
+                                         .pitch = packed->pitch,
+                                         .pixels = packed->pixels,
+                                         .surface = nullptr});
+                continue;
+            }
+            SDL_Surface* surface = DecodeImage(request.filePaths[i]);
+            result.levels.push_back({.width = surface->w,
+                                     .height = surface->h,
+                                     .pitch = surface->pitch,
+                                     .pixels = surface->pixels,
+                                     .surface = surface});
+        }
+        if (!request.generateMipmaps) { return result; }
+
+        // Halve from the largest level down, switching to a source level wherever one is at least the next size:
+        // drawn at that size, it looks better than a filtered copy
+        std::vector<LevelPixels> sources(result.levels.begin() + 1, result.levels.end());
+        std::ranges::sort(sources, std::ranges::greater{}, &LevelPixels::width);
+        std::size_t nextSource = 0;
+        LevelPixels current = result.levels.front();
+        while (current.width > MIN_MIPMAP_SIZE || current.height > MIN_MIPMAP_SIZE)
+        {
+            const int halfWidth = std::max(current.width / 2, 1);
+            while (nextSource < sources.size() && sources[nextSource].width >= current.width) { ++nextSource; }
+            if (nextSource < sources.size() && sources[nextSource].width >= halfWidth)
+            {
+                current = sources[nextSource++];
+                continue;
+            }
+            SDL_Surface* half = HalveImage(current.width, current.height, current.pixels, current.pitch);
+            current = {
+                .width = half->w, .height = half->h, .pitch = half->pitch, .pixels = half->pixels, .surface = half};
+            result.levels.push_back(current);
+        }
+    }
+    catch (...)
+    {
+        destroySurfaces(result);
+        throw;
+    }
+    return result;
+}
+
+void PF::TextureManager::destroySurfaces(LoadResult& result)
+{
+    for (const LevelPixels& level : result.levels) { SDL_DestroySurface(level.surface); }
+    result.levels.clear();
+}
+
+void PF::TextureManager::uploadLevels(LoadResult& result)
+{
+    CachedImage& image = m_images[result.handle];
+    const LevelPixels& base = result.levels.front();
+    image.levels.clear();
+    try
+    {
+        for (const LevelPixels& level : result.levels)
+        {
+            AtlasRegion region = upload(level.width, level.height, level.pixels, level.pitch);
+            region.scale = {static_cast<float>(level.width) / static_cast<float>(base.width),
+                            static_cast<float>(level.height) / static_cast<float>(base.height)};
+            image.levels.push_back(region);
+        }
+    }
+    catch (...)
+    {
+        image.levels.clear();  // Their space stays taken until their pages are evicted
+        destroySurfaces(result);
+        throw;
+    }
+    const bool packed = base.surface == nullptr;
+    destroySurfaces(result);  // done with these, the pages have a copy of the pixels now.
+
+    image.region = image.levels.front();
+    std::ranges::sort(image.levels, std::ranges::greater{}, [](const AtlasRegion& level) { return level.scale.x; });
+    image.residency = Residency::RESIDENT;
+    PF_LOG_INFO("Texture added from %s: %s (atlas page %zu, %zu levels)",
+                packed ? "pack" : "file",
+                result.filePath,
+                image.region.page,
+                image.levels.size());
+}
+
+PF::AtlasRegion PF::TextureManager::upload(int width, int height, const void* pixels, int pitch)
+{
+    const AtlasRegion region = allocate(width, height);
+    const SDL_Rect area = {static_cast<int>(region.rect.x), static_cast<int>(region.rect.y), width, height};
+    m_pages[region.page].update(area, pixels, pitch);
+    return region;
+}
+
+const PF::AssetPack::Image* PF::TextureManager::findPacked(std::string_view filePath) const
+{
+    const std::string name = std::filesystem::path(filePath).filename().string();
+    for (auto pack = m_packs.rbegin(); pack != m_packs.rend(); ++pack)
+    {
+        if (const AssetPack::Image* image = pack->find(name)) { return image; }
+    }
+    return nullptr;
+}
+
+std::pair<std::size_t, bool> PF::TextureManager::findOrInsert(std::string_view filePath,
+                                                             const PF::TextureOptions& options)
+{
+    // Different spellings of the same file share an entry, whether the file exists yet or not
+    std::error_code error;
+    const std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(filePath, error);
+    std::string key = error ? std::string{filePath} : canonicalPath.generic_string();
+
+    const auto found = m_cache.find(key);
+    if (found == m_cache.end())
+    {
+        ++m_stats.misses;
+        m_images.push_back({.key = key, .options = options});
+        m_cache.emplace(std::move(key), m_images.size() - 1);
+        return {m_images.size() - 1, false};
+    }
+
+    // An evicted image keeps its index, and is loaded again into it
+    const bool cached = m_images[found->second].residency != Residency::EVICTED;
+    ++(cached ? m_stats.hits : m_stats.misses);
+    return {found->second, cached};
+}
+
+void PF::TextureManager::retain(std::size_t handle) { ++m_images[handle].referenceCount; }
+
+void PF::TextureManager::release(std::size_t handle)
+{
+    CachedImage& image = m_images[handle];
+    assert(image.referenceCount > 0 && "Texture released more often than retained.");
+    if (--image.referenceCount == 0) { image.releasedAt = ++m_releaseClock; }
+}
+
+void PF::TextureManager::trimToBudget(std::size_t incomingBytes)
+{
+    while (m_residentBytes + incomingBytes > m_memoryBudget)
+    {
+        // Least recently released page first, judged by its most recently released image
+        std::size_t victim = m_pages.size();
+        Uint64 victimReleasedAt = 0;
+        for (std::size_t page = 0; page < m_pages.size(); ++page)
+        {
+            if (!isEvictable(page)) { continue; }
+            Uint64 releasedAt = 0;
+            for (const CachedImage& image : m_images)
+            {
+                if (image.residency == Residency::RESIDENT && image.isOnPage(page))
+                {
+                    releasedAt = std::max(releasedAt, image.releasedAt);
+                }
+            }
+            if (victim == m_pages.size() || releasedAt < victimReleasedAt)
+            {
+                victim = page;
+                victimReleasedAt = releasedAt;
+            }
+        }
+        if (victim == m_pages.size()) { return; }  // Everything left is in use
+        evict(victim);
+    }
+}
+
+bool PF::TextureManager::isEvictable(std::size_t page) const
+{
+    if (!m_pages[page].isCreated() || (m_placeholderUploaded && m_placeholder.page == page)) { return false; }
+    return std::ranges::none_of(
+        m_images,
+        [page](const CachedImage& image)
+        {
+            // An image still being uploaded holds on to every level it placed so far
+            if (image.residency == Residency::LOADING)
+            {
+                return std::ranges::any_of(image.levels,
+                                           [page](const AtlasRegion& level) { return level.page == page; });
+            }
+            return image.residency == Residency::RESIDENT && image.isOnPage(page) && image.referenceCount > 0;
+        });
+}
+
+bool PF::TextureManager::CachedImage::isOnPage(std::size_t page) const
+{
+    return region.page == page ||
+           std::ranges::any_of(levels, [page](const AtlasRegion& level) { return level.page == page; });
+}
+
+void PF::TextureManager::evict(std::size_t page)
+{
+    std::size_t evictedImages = 0;
+    for (CachedImage& image : m_images)
+    {
+        // Levels on other pages keep their space until those pages go too
+        if (image.residency != Residency::RESIDENT || !image.isOnPage(page)) { continue; }
+        image.region = {.ready = false};
+        image.levels.clear();
+        image.residency = Residency::EVICTED;
+        ++evictedImages;
+    }
+
+    const AtlasPacker& packer = m_packers[page];
+    m_residentBytes -= PageBytes(packer.getWidth(), packer.getHeight());
+    m_pages[page] = Texture{};  // Destroys the SDL_Texture, the slot is reused by the next page opened
+    ++m_stats.evictions;
+    PF_LOG_INFO("Atlas page %zu evicted (%zu unused images), %zu bytes resident", page, evictedImages, m_residentBytes);
+}
 
-std::size_t PF::TextureManager::addTexture(std::string_view filePath)
+PF::AtlasRegion PF::TextureManager::allocate(int width, int height)
 {
-    m_textures.emplace_back(m_renderer, filePath);
-    SDL_Log("Texture added from file: %s\n", std::string{filePath}.c_str());
-    return m_textures.size() - 1;  // Return the index of the added texture
+    const int paddedWidth = width + (2 * ATLAS_PADDING);
+    const int paddedHeight = height + (2 * ATLAS_PADDING);
+    const auto toRegion = [&](std::size_t page, const SDL_Rect& placed)
+    {
+        return AtlasRegion{.page = page,
+                           .rect = {static_cast<float>(placed.x + ATLAS_PADDING),
+                                    static_cast<float>(placed.y + ATLAS_PADDING),
+                                    static_cast<float>(width),
+                                    static_cast<float>(height)}};
+    };
+
+    for (std::size_t page = 0; page < m_packers.size(); ++page)
+    {
+        if (!m_pages[page].isCreated()) { continue; }
+        if (const auto placed = m_packers[page].insert(paddedWidth, paddedHeight)) { return toRegion(page, *placed); }
+    }
+
+    // No room left: open a page, as large as the image if it does not fit in a regular one
+    const int pageWidth = std::max(m_pageSize, paddedWidth);
+    const int pageHeight = std::max(m_pageSize, paddedHeight);
+    trimToBudget(PageBytes(pageWidth, pageHeight));
+
+    const auto freeSlot = std::ranges::find_if_not(m_pages, &Texture::isCreated);
+    const auto page = static_cast<std::size_t>(std::distance(m_pages.begin(), freeSlot));
+    if (freeSlot == m_pages.end())
+    {
+        m_pages.emplace_back(m_renderer, pageWidth, pageHeight);
+        m_packers.emplace_back(pageWidth, pageHeight);
+    }
+    else
+    {
+        *freeSlot = Texture(m_renderer, pageWidth, pageHeight);
+        m_packers[page] = AtlasPacker(pageWidth, pageHeight);
+    }
+    m_residentBytes += PageBytes(pageWidth, pageHeight);
+    if (m_residentBytes > m_memoryBudget)
+    {
+        PF_LOG_WARNING("Atlas pages exceed the memory budget: %zu / %zu bytes", m_residentBytes, m_memoryBudget);
+    }
+
+    const auto placed = m_packers[page].insert(paddedWidth, paddedHeight);
+    assert(placed && "A fresh atlas page must fit the image it was opened for.");
+    return toRegion(page, *placed);
+}
+
+const PF::AtlasRegion& PF::TextureManager::getRegion(std::size_t handle) const
+{
+    if (handle >= m_images.size()) { throw std::out_of_range("Texture handle out of range"); }
+    const AtlasRegion& region = m_images[handle].region;
+    return region.ready ? region : m_placeholder;
 }
 
-const PF::Texture& PF::TextureManager::getTexture(std::size_t index) const
+const PF::AtlasRegion& PF::TextureManager::getRegion(std::size_t handle, float drawScale) const
 {
-    if (index >= m_textures.size()) { throw std::out_of_range("Texture index out of range"); }
-    return m_textures[index];
+    const AtlasRegion& region = getRegion(handle);
+    const std::vector<AtlasRegion>& levels = m_images[handle].levels;
+    if (!region.ready || levels.size() < 2) { return region; }
+
+    // Ratio between the two scales, 1 when equal: the levels are sorted, so it falls and then rises again
+    const float scale = std::max(drawScale, std::numeric_limits<float>::min());
+    const auto distance = [scale](const AtlasRegion& level)
+    { return level.scale.x > scale ? level.scale.x / scale : scale / level.scale.x; };
+    std::size_t best = 0;
+    while (best + 1 < levels.size() && distance(levels[best + 1]) < distance(levels[best])) { ++best; }
+    return levels[best];
+}
+
+const PF::Texture& PF::TextureManager::getPage(std::size_t page) const
+{
+    if (page >= m_pages.size()) { throw std::out_of_range("Atlas page index out of range"); }
+    return m_pages[page];
 }
+
+std::size_t PF::TextureManager::getPageCount() const { return m_pages.size(); }
+
+bool PF::TextureManager::isHeadless() const { return m_renderer == nullptr; }
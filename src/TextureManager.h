@@ -3,74 +3,440 @@
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "AssetPack.h"
+#include "AtlasPacker.h"
+
 namespace PF
 {
+class TextureManager;
+
 /**
  * @class Texture
- * @brief Represents a texture loaded from an image file and managed by SDL.
+ * @brief Represents a texture managed by SDL, used as an atlas page.
  *
- * This class encapsulates the creation of an SDL_Texture from an image file.
- * It ensures proper resource management and provides a simple interface
- * for loading textures.
+ * This class encapsulates the creation of an empty SDL_Texture that images are later copied into, and destroys it
+ * along with the object. Textures can be moved but not copied, so only one object ever owns an SDL_Texture.
  */
 class Texture
 {
   public:
     /**
-     * @brief Constructs a Texture object by loading an image file.
+     * @brief Constructs an empty Texture, standing in for a page that was evicted or never created.
+     */
+    Texture() = default;
+
+    /**
+     * @brief Constructs a transparent RGBA texture.
      * @param renderer The SDL_Renderer used to create the texture.
-     * @param filePath The path to the image file to load.
-     * @throws std::runtime_error if the image file cannot be loaded or the texture cannot be created.
+     * @param width The texture width, in pixels.
+     * @param height The texture height, in pixels.
+     * @throws PF::SDLException if the texture cannot be created or cleared.
      */
-    Texture(SDL_Renderer* renderer, std::string_view filePath);
+    Texture(SDL_Renderer* renderer, int width, int height);
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+    Texture(Texture&& other) noexcept;
+    Texture& operator=(Texture&& other) noexcept;
+
+    ~Texture();
+
+    /**
+     * @brief Copies pixels into a part of the texture.
+     * @param area The destination area, in pixels.
+     * @param pixels The pixels to copy, in SDL_PIXELFORMAT_RGBA32, `area.w` by `area.h`.
+     * @param pitch The number of bytes between two rows of `pixels`.
+     * @throws PF::SDLException if the upload fails.
+     */
+    void update(const SDL_Rect& area, const void* pixels, int pitch) const;
 
     [[nodiscard]] SDL_Texture& get() const;
     SDL_Texture& operator->() const;
     SDL_Texture& operator*() const;
 
+    /**
+     * @brief Checks whether the object owns an SDL_Texture.
+     */
+    [[nodiscard]] bool isCreated() const;
+
   private:
     SDL_Texture* m_texture = nullptr; /**< The SDL_Texture managed by this class. */
 };
 
+/**
+ * @class TextureHandle
+ * @brief A counted reference to an image of a TextureManager, which keeps it from being evicted.
+ *
+ * Copies share the image and add to its reference count; the image becomes evictable once the last one is destroyed.
+ * Entities only store the plain index from get(): the handle belongs to whoever asked for the image, e.g. the game for
+ * its sprites. Handles must not outlive their manager, and must be copied and destroyed on the thread using it.
+ */
+class TextureHandle
+{
+  public:
+    TextureHandle() = default;  // Refers to nothing
+    TextureHandle(const TextureHandle& other);
+    TextureHandle& operator=(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(TextureHandle&& other) noexcept;
+    ~TextureHandle();
+
+    /**
+     * @brief Gets the index of the image, to resolve with TextureManager::getRegion().
+     */
+    [[nodiscard]] std::size_t get() const;
+
+    /**
+     * @brief Drops the reference, leaving the handle empty.
+     */
+    void reset();
+
+    [[nodiscard]] explicit operator bool() const;
+
+  private:
+    friend class TextureManager;
+
+    TextureHandle(PF::TextureManager* manager, std::size_t index);  // Adds a reference
+
+  private:
+    PF::TextureManager* m_manager = nullptr;
+    std::size_t m_index = 0;
+};
+
+/**
+ * @struct TextureCacheStats
+ * @brief What a TextureManager holds, and how often it could serve an image it already had.
+ */
+struct TextureCacheStats
+{
+    std::size_t hits = 0;              // Requests for an image already loaded or loading
+    std::size_t misses = 0;            // Requests that had to load their image
+    std::size_t evictions = 0;         // Atlas pages destroyed to stay within the memory budget
+    std::size_t residentBytes = 0;     // Memory held by the atlas pages
+    std::size_t residentPages = 0;     // Atlas pages currently created
+    std::size_t referencedImages = 0;  // Images at least one handle refers to
+};
+
+/**
+ * @struct TextureOptions
+ * @brief Smaller copies to keep of an image, so it can be drawn small without sampling all of its pixels.
+ */
+struct TextureOptions
+{
+    std::vector<std::string> levelPaths;  // Other source resolutions of the same image, e.g. redrawn at a smaller size
+    bool generateMipmaps = false;         // Whether to fill in halved copies, down to MIN_MIPMAP_SIZE
+};
+
+/**
+ * @struct AtlasRegion
+ * @brief Locates an image, or one of its levels, inside the atlas: which page holds it, and where.
+ */
+struct AtlasRegion
+{
+    std::size_t page = 0;
+    SDL_FRect rect = {0, 0, 0, 0};  // Area of the image inside the page, in pixels
+    SDL_FPoint scale = {1, 1};      // Pixels of this level per pixel of the image it was added as
+    bool ready = true;              // False while the image is loading and the region shows the placeholder
+
+    /**
+     * @brief Converts a source rectangle relative to the image into one relative to the page. The placeholder is
+     * drawn whole, whatever part of the image was asked for.
+     */
+    [[nodiscard]] SDL_FRect toPage(const SDL_FRect& srcRect) const
+    {
+        if (!ready) { return rect; }
+        return {rect.x + (srcRect.x * scale.x),
+                rect.y + (srcRect.y * scale.y),
+                srcRect.w * scale.x,
+                srcRect.h * scale.y};
+    }
+};
+
 /**
  * @class TextureManager
- * @brief Manages a collection of textures.
+ * @brief Manages the images drawn by the game, packed together into a few atlas pages.
+ *
+ * Every image added to the manager is copied into a large page texture next to the others, so sprites using
+ * different images still share a texture and end up in the same sprite batch. A new page is only opened when the
+ * current ones are full. Images larger than a page get a page of their own.
+ *
+ * Images can also be loaded asynchronously: a background thread reads and decodes them, and the render thread only
+ * copies the decoded pixels into the atlas, within a time budget per frame. Until then, their handle resolves to a
+ * placeholder.
  *
- * This class provides functionality to load and store multiple textures.
- * It allows adding textures by specifying their file paths and keeps track
- * of all loaded textures.
+ * Images found in a mounted asset pack skip both the file lookup and the decoding: their pixels are copied to the
+ * atlas straight from the mapped pack.
+ *
+ * Images are cached by canonical path: asking again for an image already loaded, or still loading, returns another
+ * handle to it. Handles count their users. When opening a page would exceed the memory budget, pages holding only
+ * images nobody refers to anymore are evicted, the least recently released first. Their images are loaded again, into
+ * the same index, if asked for later.
+ *
+ * An image can come in several levels of detail: smaller source files of it, and mipmaps generated by halving it.
+ * All of them are uploaded along with the image, and drawing picks the level closest to the size on screen, so small
+ * sprites sample a small copy instead of minifying the full image.
  */
 class TextureManager
 {
   public:
+    static constexpr int ATLAS_PAGE_SIZE = 2048;  // Side of an atlas page, in pixels, if the renderer supports it
+    static constexpr int ATLAS_PADDING = 1;       // Transparent gap around every image, so filtering does not bleed
+    static constexpr std::size_t DEFAULT_MEMORY_BUDGET = std::size_t{256} * 1024 * 1024;  // Bytes of atlas pages
+    static constexpr int MIN_MIPMAP_SIZE = 4;  // Generated mipmaps stop once both sides are this small
+
     /**
-     * @brief Constructs a TextureManager object.
-     * @param renderer The SDL_Renderer used to create textures.
+     * @brief Constructs a TextureManager object. Creates no texture yet, so it may run on any thread.
+     * @param renderer The SDL_Renderer used to create textures, or nullptr to run headless. Headless managers hand
+     * out valid handles but skip decoding and uploading the images.
      */
     explicit TextureManager(SDL_Renderer* renderer);
 
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+    TextureManager(TextureManager&&) = delete;
+    TextureManager& operator=(TextureManager&&) = delete;
+
     /**
-     * @brief Adds a texture to the manager by loading it from a file.
-     * @param renderer The SDL_Renderer used to create the texture.
+     * @brief Stops the loading thread and frees the images it decoded but that were never uploaded.
+     */
+    ~TextureManager();
+
+    /**
+     * @brief Maps an asset pack, so that images it contains are no longer loaded from their own file.
+     *
+     * Images are matched by file name, e.g. "../../assets/BaseCell_64x64.png" is found as "BaseCell_64x64.png".
+     * Packs mounted later take precedence.
+     *
+     * @param packPath The path to a pack written by perfectform_packer.
+     * @throws PF::Exception if the pack cannot be mapped or is invalid.
+     */
+    void mountPack(std::string_view packPath);
+
+    /**
+     * @brief Adds an image to the atlas by loading it from a mounted pack, or else from a file, unless it is cached.
+     * An image still loading in the background keeps showing the placeholder until uploaded.
      * @param filePath The path to the image file to load.
-     * @return The index of the added texture in the internal collection.
+     * @param options Its other levels of detail. Only the first request for an image uses them.
+     * @return A handle to the image.
+     * @throws PF::SDLException if the image or one of its levels cannot be loaded or uploaded.
      */
-    std::size_t addTexture(std::string_view filePath);
+    PF::TextureHandle addTexture(std::string_view filePath, const PF::TextureOptions& options = {});
 
     /**
-     * @brief Retrieves the texture at the specified index.
-     * @param index The index of the texture to retrieve.
-     * @return A reference to the texture at the specified index.
-     * @throws std::out_of_range if the index is invalid.
+     * @brief Queues an image for loading on the background thread and returns at once. Images found in a mounted
+     * pack skip the loading thread and only wait for the next uploadLoaded().
+     *
+     * The handle resolves to the placeholder until uploadLoaded() copied the image into the atlas. Images that fail
+     * to load are logged and keep the placeholder. Unlike addTexture(), this never touches the renderer, so a scene
+     * can register its images while being built on another thread.
+     *
+     * @param filePath The path to the image file to load.
+     * @param options Its other levels of detail, decoded and generated on the background thread as well. Only the
+     * first request for an image uses them.
+     * @return A handle to the image, which is only loaded if not cached yet.
      */
-    [[nodiscard]] const Texture& getTexture(std::size_t index) const;
+    PF::TextureHandle addTextureAsync(std::string_view filePath, const PF::TextureOptions& options = {});
+
+    /**
+     * @brief Copies images decoded by the background thread into the atlas, after the placeholder on the first call.
+     * Must run on the render thread, at least once before anything is drawn.
+     * @param budgetNs Time after which no further image is uploaded this call. At least one image is uploaded per
+     * call, so loading always progresses.
+     * @return The number of images uploaded.
+     */
+    std::size_t uploadLoaded(Uint64 budgetNs);
+
+    /**
+     * @brief Sets how much memory the atlas pages may take before unreferenced ones are evicted. Pages still in use
+     * are never evicted, so the budget may be exceeded until they are released.
+     */
+    void setMemoryBudget(std::size_t bytes);
+
+    [[nodiscard]] std::size_t getMemoryBudget() const;
+
+    [[nodiscard]] PF::TextureCacheStats getCacheStats() const;
+
+    /**
+     * @brief Gets the number of asynchronous loads not uploaded yet, including the ones still decoding.
+     */
+    [[nodiscard]] std::size_t getPendingCount() const;
+
+    /**
+     * @brief Retrieves where an image lives in the atlas, or the placeholder while it is not there.
+     * @param handle The index of a handle returned by addTexture().
+     * @throws std::out_of_range if the handle is invalid.
+     */
+    [[nodiscard]] const AtlasRegion& getRegion(std::size_t handle) const;
+
+    /**
+     * @brief Retrieves the level of an image closest to the size it is drawn at, or the placeholder while it is not
+     * in the atlas.
+     * @param handle The index of a handle returned by addTexture().
+     * @param drawScale Screen pixels per pixel of the image, e.g. 0.25 for a 64 pixel wide image drawn 16 pixels wide.
+     * @throws std::out_of_range if the handle is invalid.
+     */
+    [[nodiscard]] const AtlasRegion& getRegion(std::size_t handle, float drawScale) const;
+
+    /**
+     * @brief Retrieves an atlas page.
+     * @param page The page index, as found in an AtlasRegion.
+     * @throws std::out_of_range if the page does not exist.
+     */
+    [[nodiscard]] const Texture& getPage(std::size_t page) const;
+
+    [[nodiscard]] std::size_t getPageCount() const;
+
+    /**
+     * @brief Checks whether the manager runs without a renderer.
+     */
+    [[nodiscard]] bool isHeadless() const;
+
+  private:
+    friend class TextureHandle;
+
+    enum class Residency
+    {
+        LOADING,   // Queued, decoding or being uploaded, shows the placeholder
+        RESIDENT,  // In an atlas page
+        EVICTED    // Not in the atlas, after its page was evicted or its loading failed
+    };
+
+    struct CachedImage
+    {
+        std::string key;                     // Canonical path, also the path it is loaded from
+        PF::TextureOptions options;          // Its other levels, loaded again along with it after an eviction
+        AtlasRegion region{.ready = false};  // Where it lives, while resident
+        std::vector<AtlasRegion> levels{};   // Every level, the image itself included, largest first, once placed
+        Residency residency = Residency::LOADING;
+        std::size_t referenceCount = 0;
+        Uint64 releasedAt = 0;  // Value of m_releaseClock when its last handle went away
+
+        /**
+         * @brief Checks whether the image has a level on the given page.
+         */
+        [[nodiscard]] bool isOnPage(std::size_t page) const;
+    };
+
+    struct LevelPixels
+    {
+        int width = 0;
+        int height = 0;
+        int pitch = 0;                   // Bytes between two rows
+        const void* pixels = nullptr;    // RGBA32
+        SDL_Surface* surface = nullptr;  // Owner of the pixels, or nullptr if they are in a mounted pack
+    };
+
+    struct LoadRequest
+    {
+        std::size_t handle = 0;
+        std::vector<std::string> filePaths;           // The image first, then its other source resolutions
+        std::vector<const AssetPack::Image*> packed;  // Parallel to filePaths, nullptr for files to decode
+        bool generateMipmaps = false;
+    };
+
+    struct LoadResult
+    {
+        std::size_t handle = 0;
+        std::string filePath;
+        std::vector<LevelPixels> levels;  // The image first, then the rest in any order, empty if loading failed
+        std::string error;
+    };
+
+    /**
+     * @brief Looks an image up in the cache, or adds it there, ready to be loaded.
+     * @return Its index, and whether it is loaded or loading already.
+     */
+    std::pair<std::size_t, bool> findOrInsert(std::string_view filePath, const PF::TextureOptions& options);
+
+    /**
+     * @brief Lists what loading an image takes, looking its levels up in the mounted packs.
+     */
+    [[nodiscard]] LoadRequest makeRequest(std::size_t handle) const;
+
+    /**
+     * @brief Decodes the levels of an image that are not in a pack, then generates the mipmaps missing between them.
+     * Safe on any thread.
+     * @throws PF::SDLException if a level cannot be loaded or a mipmap created.
+     * @throws std::filesystem::filesystem_error if a path does not resolve.
+     */
+    static LoadResult load(const LoadRequest& request);
+
+    static void destroySurfaces(LoadResult& result);
+
+    /**
+     * @brief Copies every level of a loaded image into the atlas, and frees their surfaces.
+     */
+    void uploadLevels(LoadResult& result);
+
+    void retain(std::size_t handle);
+    void release(std::size_t handle);
+
+    /**
+     * @brief Evicts pages nobody uses, least recently released first, until `incomingBytes` more fit in the budget or
+     * no page is left to evict.
+     */
+    void trimToBudget(std::size_t incomingBytes);
+
+    /**
+     * @brief Checks whether every image on a page is resident but unreferenced, and the page is not the placeholder's.
+     *
+     * A page holding a level of an image still being uploaded is never evictable, so the image cannot end up pointing
+     * at a page that was reset and reused for its next level.
+     */
+    [[nodiscard]] bool isEvictable(std::size_t page) const;
+
+    void evict(std::size_t page);
+
+    /**
+     * @brief Finds room for an image of the given size, opening a new page if none of the current ones fits it.
+     */
+    AtlasRegion allocate(int width, int height);
+
+    /**
+     * @brief Copies RGBA32 pixels into the atlas and returns where they went.
+     */
+    AtlasRegion upload(int width, int height, const void* pixels, int pitch);
+
+    /**
+     * @brief Looks an image up in the mounted packs by its file name.
+     * @return The packed image, or nullptr if no pack contains it.
+     */
+    [[nodiscard]] const AssetPack::Image* findPacked(std::string_view filePath) const;
+
+    void loadImages(std::stop_token stopToken);  // Body of the loading thread
 
   private:
     SDL_Renderer* m_renderer;
-    std::vector<Texture> m_textures; /**< Collection of loaded textures. */
+    int m_pageSize = ATLAS_PAGE_SIZE;
+    std::vector<Texture> m_pages;                         /**< Atlas page textures, empty once evicted. */
+    std::vector<AtlasPacker> m_packers;                   /**< Free space of each page, parallel to m_pages. */
+    std::vector<CachedImage> m_images;                    /**< Every image ever requested, indexed by handle. */
+    std::unordered_map<std::string, std::size_t> m_cache; /**< Index of every image, by canonical path. */
+    std::vector<AssetPack> m_packs;                       /**< Mounted asset packs, in mounting order. */
+    AtlasRegion m_placeholder;                            /**< Region shown for images still loading. */
+    bool m_placeholderUploaded = false;                   /**< Whether m_placeholder points to actual pixels yet. */
+    std::size_t m_pendingCount = 0;                       /**< Asynchronous loads not uploaded yet. */
+    std::size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+    std::size_t m_residentBytes = 0;                      /**< Memory held by the created pages. */
+    Uint64 m_releaseClock = 0;                            /**< Counts releases, to order them. */
+    PF::TextureCacheStats m_stats;                        /**< Hits, misses and evictions, the rest on demand. */
+
+    std::mutex m_loadMutex;                 /**< Guards both queues below. */
+    std::condition_variable_any m_loadWake; /**< Signalled when a request is queued. */
+    std::deque<LoadRequest> m_requests;     /**< Images waiting for the loading thread. */
+    std::deque<LoadResult> m_results;       /**< Decoded images waiting for uploadLoaded(). */
+    std::jthread m_loader;                  /**< Started by the first asynchronous load, declared last to stop first. */
 };
 }  // namespace PF
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace PF
+{
+/**
+ * @class TripleBuffer
+ * @brief Hands the latest of a stream of values from one producer thread to one consumer thread, without locking.
+ *
+ * The producer fills the write buffer and publishes it; the consumer latches the most recent published buffer and
+ * reads it for as long as it likes. Each side owns one of the three buffers at any time, and the third is swapped
+ * between them through a single atomic, so neither ever waits for the other. Values published while the consumer
+ * was busy are skipped: only the latest one matters.
+ *
+ * The buffers are reused, so a value holding vectors keeps their capacity and publishing does not allocate once they
+ * have grown.
+ */
+template<typename T>
+class TripleBuffer
+{
+  public:
+    /**
+     * @brief Gets the buffer to fill before the next publish(). Producer only.
+     */
+    [[nodiscard]] T& getWriteBuffer() { return m_buffers[m_writeIndex]; }
+
+    /**
+     * @brief Makes the write buffer the latest value, and takes the spare one as the next write buffer. Producer only.
+     */
+    void publish()
+    {
+        const std::uint8_t previous = m_spare.exchange(m_writeIndex | FRESH, std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Latches the latest published value, if a new one arrived since the last call. Consumer only.
+     * @return True if the read buffer changed.
+     */
+    bool acquire()
+    {
+        if ((m_spare.load(std::memory_order_relaxed) & FRESH) == 0) { return false; }
+        const std::uint8_t previous = m_spare.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Gets the value latched by the last acquire(). Consumer only.
+     */
+    [[nodiscard]] const T& getReadBuffer() const { return m_buffers[m_readIndex]; }
+
+  private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;  // Set while the spare buffer holds a value the consumer has not seen
+
+    std::array<T, 3> m_buffers{};
+    std::uint8_t m_writeIndex = 0;         // Producer's buffer
+    std::atomic<std::uint8_t> m_spare{1};  // Buffer in between, and whether it is fresh
+    std::uint8_t m_readIndex = 2;          // Consumer's buffer
+};
+}  // namespace PF
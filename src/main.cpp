@@ -5,19 +5,38 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3_image/SDL_image.h>
 
+#include <charconv>
+#include <cstddef>
 #include <exception>
 #include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "AllocationTracker.h"
 #include "Exceptions.h"
+#include "FixedTimestep.h"
 #include "Game.h"
 #include "GlobalDefinitions.h"
+#include "HeadlessSimulation.h"
+#include "InputRecording.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "RenderSnapshot.h"
+#include "SceneManager.h"
+#include "SimulationThread.h"
+
+constexpr const char* TRACE_FILE_PATH = "perfectform_trace.json";  // Written when pressing F4
+constexpr Uint64 SIMULATION_STEP_NS = static_cast<Uint64>(PF::Global::Model::SIMULATION_STEP_RATE_MS) * SDL_NS_PER_MS;
 
 namespace
 {
 [[nodiscard("Exception being handled and returning app failure")]]
 SDL_AppResult LogException(const char* msg, SDL_Window* window = nullptr)
 {
+    PF::Log::flush();  // Everything logged before the error first
     SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s", msg);
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", msg, window);
     return SDL_APP_FAILURE;
@@ -28,9 +47,14 @@ struct AppState
     SDL_Window* window{nullptr};
     SDL_Renderer* renderer{nullptr};
 
-    Uint64 lastStep{0};
+    PF::SceneManager scenes;
+    PF::Game* game{nullptr};                                    // Top scene of `scenes`, owned by it
+    std::unique_ptr<PF::SimulationThread> simulation{nullptr};  // Steps `game`, declared after `scenes` to stop first
 
-    std::unique_ptr<PF::Game> game{nullptr};
+    bool showProfiler{false};    // Toggled with F3
+    std::string recordPath;      // Where to save the recorded input on quit, empty when not recording
+    bool replaying{false};       // Whether the game plays back a recording instead of live input
+    std::size_t threadCount{0};  // Threads updating the entities of every game, zero for one per hardware thread
 };
 
 std::unique_ptr<AppState> g_appState{nullptr};
@@ -41,6 +65,22 @@ struct AppMetadata
     const char* value;
 };
 
+struct CommandLine
+{
+    bool headless{false};          // Run the simulation without window or renderer, then quit
+    std::size_t headlessTicks{0};  // Number of ticks to simulate in headless mode
+    bool checkAllocations{false};  // Fail the headless run if a tick allocates past the warm-up
+    std::size_t threadCount{0};    // Threads updating the entities, zero for one per hardware thread
+    std::string recordPath;        // Where to save the session's input on quit, empty to not record
+    std::string replayPath;        // Session to play back instead of live input, empty to play live
+};
+
+std::unique_ptr<PF::SimulationThread> StartSimulation(PF::Game& game)
+{
+    return std::make_unique<PF::SimulationThread>(
+        game, PF::FixedTimestep{SIMULATION_STEP_NS, PF::Global::Model::MAX_CATCH_UP_STEPS});
+}
+
 }  // namespace
 
 SDL_AppResult SDL_AppIterate(void* appState)
@@ -48,35 +88,53 @@ SDL_AppResult SDL_AppIterate(void* appState)
     auto* state = static_cast<AppState*>(appState);
     try
     {
-        const Uint64 now = SDL_GetTicks();
+        state->simulation->rethrowFailure();
 
-        // FIXME: this can become unsafe very easily, we need to ensure lastStep is always less than now.
-        // run game logic if we're at or past the time to run it.
-        // if we're _really_ behind the time to run it, run it
-        // several times.
-        while ((now - state->lastStep) >= PF::Global::Model::SIMULATION_STEP_RATE_MS)
+        // A game preloaded with F5 takes over as soon as its images are on the GPU
+        if (state->scenes.isPreloadReady())
         {
-            const Uint64 stepMs = now - state->lastStep;
-            state->game->update(stepMs);
+            state->simulation->stop();
 
-            // TODO: increment this by any means necessary!
-            state->lastStep += PF::Global::Model::SIMULATION_STEP_RATE_MS;
+            // Games are the only scenes preloaded so far
+            state->game = &static_cast<PF::Game&>(state->scenes.switchToPreloaded());
+            state->simulation = StartSimulation(*state->game);
         }
 
-        // Clear the renderer with a color
-        if (!SDL_SetRenderDrawColorFloat(state->renderer,
-                                         PF::Global::Colors::BLACK.r,
-                                         PF::Global::Colors::BLACK.g,
-                                         PF::Global::Colors::BLACK.b,
-                                         PF::Global::Colors::BLACK.a))
+        // The latest state the simulation thread published, drawn and checked this frame
+        const PF::RenderSnapshot& snapshot = state->game->acquireSnapshot();
+
         {
-            throw PF::SDLException("Failed to set renderer clear color.");
-        }
-        if (!SDL_RenderClear(state->renderer)) { throw PF::SDLException("Failed to clear renderer."); }
+            PF_PROFILE_ZONE("Render");
 
-        state->game->render();  // Render the game objects
+            // Clear the renderer with a color
+            if (!SDL_SetRenderDrawColorFloat(state->renderer,
+                                             PF::Global::Colors::BLACK.r,
+                                             PF::Global::Colors::BLACK.g,
+                                             PF::Global::Colors::BLACK.b,
+                                             PF::Global::Colors::BLACK.a))
+            {
+                throw PF::SDLException("Failed to set renderer clear color.");
+            }
+            if (!SDL_RenderClear(state->renderer)) { throw PF::SDLException("Failed to clear renderer."); }
 
-        if (!SDL_RenderPresent(state->renderer)) { throw PF::SDLException("Failed to present renderer."); }
+            state->scenes.uploadTextures();  // Upload the images decoded since the last frame
+
+            // Render the game objects between the snapshot's last two steps, interpolated up to now
+            state->scenes.render(snapshot.getAlpha(SDL_GetTicksNS(), SIMULATION_STEP_NS));
+            if (state->showProfiler) { state->game->renderProfilerOverlay(); }
+        }
+        {
+            PF_PROFILE_ZONE("Present");
+            if (!SDL_RenderPresent(state->renderer)) { throw PF::SDLException("Failed to present renderer."); }
+        }
+        state->scenes.releaseRetired();  // Only once presented, so the frame never waits for a scene's teardown
+        PF::Profiler::endFrame();
+
+        if (snapshot.replayFinished)
+        {
+            PF_LOG_INFO("Replay finished after %llu ticks.", snapshot.tick);
+            return SDL_APP_SUCCESS;
+        }
     }
     catch (const PF::SDLException& e)
     {
@@ -91,6 +149,28 @@ SDL_AppResult SDL_AppIterate(void* appState)
 
 namespace
 {
+Uint64 MakeSeed() { return (static_cast<Uint64>(SDL_rand_bits()) << 32U) | SDL_rand_bits(); }
+
+/**
+ * @brief Builds a fresh game with a new seed in the background, to replace the current one once loaded.
+ */
+void PreloadNewGame(AppState& state)
+{
+    if (state.replaying || !state.recordPath.empty())
+    {
+        PF_LOG_INFO("A new game cannot be started while recording or replaying.");
+        return;
+    }
+    if (state.scenes.isPreloading())
+    {
+        PF_LOG_INFO("A new game is already loading.");
+        return;
+    }
+
+    state.scenes.preload([renderer = state.renderer, threadCount = state.threadCount, seed = MakeSeed()]
+                         { return std::make_unique<PF::Game>(renderer, threadCount, seed); });
+}
+
 void SetAppMetadata()
 {
     const std::vector<AppMetadata> extendedMetadata{
@@ -112,6 +192,75 @@ void SetAppMetadata()
     }
 }
 
+std::size_t ParseCount(std::string_view option, std::string_view value)
+{
+    std::size_t count = 0;
+    const char* last = value.data() + value.size();
+    const auto [end, error] = std::from_chars(value.data(), last, count);
+    if (error != std::errc{} || end != last)
+    {
+        throw PF::Exception(std::format("Invalid count for {}: {}", option, value));
+    }
+    return count;
+}
+
+CommandLine ParseCommandLine(int argc, char* argv[])
+{
+    CommandLine commandLine;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--check-allocations")
+        {
+            commandLine.checkAllocations = true;
+            continue;
+        }
+        if (argument != "--headless" && argument != "--threads" && argument != "--record" && argument != "--replay")
+        {
+            throw PF::Exception(std::format("Unknown command line argument: {}", argument));
+        }
+        if (i + 1 >= argc) { throw PF::Exception(std::format("{} expects a value.", argument)); }
+
+        const std::string_view value = argv[++i];
+        if (argument == "--headless")
+        {
+            commandLine.headless = true;
+            commandLine.headlessTicks = ParseCount(argument, value);
+        }
+        else if (argument == "--threads") { commandLine.threadCount = ParseCount(argument, value); }
+        else if (argument == "--record") { commandLine.recordPath = value; }
+        else { commandLine.replayPath = value; }
+    }
+    if (!commandLine.recordPath.empty() && !commandLine.replayPath.empty())
+    {
+        throw PF::Exception("--record and --replay cannot be combined.");
+    }
+    if (commandLine.checkAllocations && !commandLine.headless)
+    {
+        throw PF::Exception("--check-allocations requires --headless.");
+    }
+    if (commandLine.checkAllocations && !PF::AllocationTracker::ENABLED)
+    {
+        throw PF::Exception("--check-allocations requires a build with PERFECTFORM_ALLOCATION_TRACKING enabled.");
+    }
+    return commandLine;
+}
+
+void SaveRecording(AppState& state)
+{
+    const auto recording = state.game->stopRecording();
+    if (!recording) { return; }
+    try
+    {
+        recording->save(state.recordPath);
+        PF_LOG_INFO("Input recording of %llu ticks saved to %s", recording->getTickCount(), state.recordPath);
+    }
+    catch (const std::exception& e)
+    {
+        PF_LOG_WARNING("%s", e.what());
+    }
+}
+
 void InitializeSDL()
 {
     if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) { throw PF::SDLException("Couldn't initialize SDL."); }
@@ -137,11 +286,32 @@ void InitializeWindowAndRenderer(std::unique_ptr<AppState>& appState)
 }
 }  // namespace
 
-SDL_AppResult SDL_AppInit(void** appState, int /*argc*/, char* /*argv*/[])
+SDL_AppResult SDL_AppInit(void** appState, int argc, char* argv[])
 {
     try
     {
+        const auto commandLine = ParseCommandLine(argc, argv);
         SetAppMetadata();
+
+        std::optional<PF::InputRecording> replay;
+        if (!commandLine.replayPath.empty()) { replay = PF::InputRecording::load(commandLine.replayPath); }
+
+        if (commandLine.headless)
+        {
+            // No video subsystem, window or renderer: simulate, report and quit
+            const auto report = PF::Headless::runSimulation(
+                commandLine.headlessTicks, commandLine.threadCount, replay ? &*replay : nullptr);
+            PF::Headless::logReport(report);
+            if (commandLine.checkAllocations && report.allocatingTicks > 0)
+            {
+                throw PF::Exception(std::format("{} ticks allocated after the warm-up ({} allocations, {} bytes).",
+                                                report.allocatingTicks,
+                                                report.steadyStateAllocations,
+                                                report.steadyStateBytes));
+            }
+            return SDL_APP_SUCCESS;
+        }
+
         InitializeSDL();
 
         g_appState = std::make_unique<AppState>();
@@ -149,10 +319,19 @@ SDL_AppResult SDL_AppInit(void** appState, int /*argc*/, char* /*argv*/[])
 
         InitializeWindowAndRenderer(g_appState);
 
-        g_appState->game = std::make_unique<PF::Game>(g_appState->renderer);
-        g_appState->lastStep = SDL_GetTicks();
+        // A live session gets a fresh seed, a replay the recorded one
+        const Uint64 seed = replay ? replay->getSeed() : MakeSeed();
+        auto game = std::make_unique<PF::Game>(g_appState->renderer, commandLine.threadCount, seed);
+        if (replay) { game->startReplay(std::move(*replay)); }
+        if (!commandLine.recordPath.empty()) { game->startRecording(); }
+        g_appState->game = game.get();
+        g_appState->scenes.push(std::move(game));
+        g_appState->recordPath = commandLine.recordPath;
+        g_appState->replaying = replay.has_value();
+        g_appState->threadCount = commandLine.threadCount;
+        g_appState->simulation = StartSimulation(*g_appState->game);
         *appState = g_appState.get();
-        SDL_Log("Application initialized successfully.");
+        PF_LOG_INFO("Application initialized successfully.");
     }
     catch (const PF::SDLException& e)
     {
@@ -171,12 +350,33 @@ SDL_AppResult SDL_AppEvent(void* appState, SDL_Event* event)
     auto* state = static_cast<AppState*>(appState);
     try
     {
+        PF_PROFILE_ZONE("Event");
+        if (event->type == SDL_EVENT_KEY_DOWN && !event->key.repeat)
+        {
+            // Debug keys, never forwarded to the game
+            if (event->key.key == SDLK_F3)
+            {
+                state->showProfiler = !state->showProfiler;
+                return SDL_APP_CONTINUE;
+            }
+            if (event->key.key == SDLK_F4)
+            {
+                PF::Profiler::dumpChromeTrace(TRACE_FILE_PATH);
+                return SDL_APP_CONTINUE;
+            }
+            if (event->key.key == SDLK_F5)
+            {
+                PreloadNewGame(*state);
+                return SDL_APP_CONTINUE;
+            }
+        }
+
         switch (event->type)
         {
             case SDL_EVENT_QUIT: return SDL_APP_SUCCESS;
             default:
             {
-                state->game->handleEvent(event);
+                state->scenes.handleEvent(event);
                 break;
             }
         }
@@ -197,8 +397,34 @@ void SDL_AppQuit(void* appState, SDL_AppResult /*result*/)
     if (appState != nullptr)
     {
         auto* state = static_cast<AppState*>(appState);
+        if (state->simulation)
+        {
+            state->simulation->stop();  // The game is only safe to read once its steps are over
+            PF_LOG_INFO("Simulation steps dropped to catch up: %llu", state->simulation->getDroppedStepCount());
+        }
+        if (state->game)
+        {
+            SaveRecording(*state);
+
+            const auto& particles = state->game->getEntities().getParticles();
+            for (std::size_t i = 0; i < particles.getEmitterCount(); ++i)
+            {
+                const PF::ParticleEmitter& emitter = particles.getEmitter(i);
+                PF_LOG_INFO("Particle emitter %zu high-water mark: %zu / %zu (%zu overflows, policy %s)",
+                            i,
+                            emitter.getHighWaterMark(),
+                            emitter.getCapacity(),
+                            emitter.getOverflowCount(),
+                            PF::toString(emitter.getOverflowPolicy()));
+            }
+        }
+
+        // Scenes hold textures and threads, and must go before the renderer
+        state->game = nullptr;
+        state->scenes.clear();
         SDL_DestroyRenderer(state->renderer);
         SDL_DestroyWindow(state->window);
     }
-    SDL_Log("Application quit successfully.");
+    PF_LOG_INFO("Application quit successfully.");
+    PF::Log::flush();
 }
@@ -0,0 +1,139 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AssetPack.h"
+#include "Exceptions.h"
+
+/**
+ * Offline packer turning image files into an asset pack the game maps at startup.
+ *
+ * Every image is decoded and converted to the atlas pixel format here, once, so loading it in the game is a plain
+ * copy out of the mapped file. Entries are named after the file name of their image, which must be unique.
+ *
+ * Usage: perfectform_packer <output.pfpack> <image> [<image>...]
+ */
+
+namespace
+{
+namespace Format = PF::AssetPackFormat;
+
+struct PackedImage
+{
+    Format::Entry entry;
+    std::vector<std::byte> pixels;  // Rows stored back to back, `entry.pitch` bytes each
+};
+
+std::uint64_t AlignUp(std::uint64_t value)
+{
+    return (value + Format::DATA_ALIGNMENT - 1) / Format::DATA_ALIGNMENT * Format::DATA_ALIGNMENT;
+}
+
+PackedImage LoadImage(const std::filesystem::path& imagePath)
+{
+    const std::string name = imagePath.filename().string();
+    if (name.size() >= Format::NAME_SIZE)
+    {
+        throw PF::Exception(std::format("Image name longer than {} characters: {}", Format::NAME_SIZE - 1, name));
+    }
+
+    SDL_Surface* fileSurface = IMG_Load(imagePath.string().c_str());
+    if (fileSurface == nullptr) { throw PF::SDLException(std::format("Couldn't load image file: {}", name)); }
+    SDL_Surface* surface = SDL_ConvertSurface(fileSurface, Format::PIXEL_FORMAT);
+    SDL_DestroySurface(fileSurface);
+    if (surface == nullptr) { throw PF::SDLException(std::format("Couldn't convert image file: {}", name)); }
+
+    // Drop the surface's row padding, if any
+    PackedImage image;
+    const auto rowSize = static_cast<std::size_t>(surface->w) * SDL_BYTESPERPIXEL(Format::PIXEL_FORMAT);
+    image.pixels.resize(rowSize * static_cast<std::size_t>(surface->h));
+    const auto* source = static_cast<const std::byte*>(surface->pixels);
+    for (int row = 0; row < surface->h; ++row)
+    {
+        std::memcpy(image.pixels.data() + (rowSize * static_cast<std::size_t>(row)),
+                    source + (static_cast<std::ptrdiff_t>(surface->pitch) * row),
+                    rowSize);
+    }
+
+    std::copy(name.begin(), name.end(), image.entry.name.begin());
+    image.entry.width = static_cast<std::uint32_t>(surface->w);
+    image.entry.height = static_cast<std::uint32_t>(surface->h);
+    image.entry.pitch = static_cast<std::uint32_t>(rowSize);
+    image.entry.format = static_cast<std::uint32_t>(Format::PIXEL_FORMAT);
+    image.entry.size = image.pixels.size();
+    SDL_DestroySurface(surface);
+    return image;
+}
+
+void WritePack(const std::filesystem::path& outputPath, std::vector<PackedImage>& images)
+{
+    Format::Header header;
+    header.entryCount = static_cast<std::uint32_t>(images.size());
+
+    // Pixel blocks follow the index, each one aligned
+    std::uint64_t offset = AlignUp(sizeof(Format::Header) + (images.size() * sizeof(Format::Entry)));
+    for (PackedImage& image : images)
+    {
+        image.entry.offset = offset;
+        offset = AlignUp(offset + image.entry.size);
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PackedImage& image : images)
+    {
+        output.write(reinterpret_cast<const char*>(&image.entry), sizeof(image.entry));
+    }
+    for (const PackedImage& image : images)
+    {
+        // Pad up to the block start, the stream position is the file size written so far
+        const std::vector<char> padding(image.entry.offset - static_cast<std::uint64_t>(output.tellp()), 0);
+        output.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        output.write(reinterpret_cast<const char*>(image.pixels.data()),
+                     static_cast<std::streamsize>(image.entry.size));
+    }
+    if (!output) { throw PF::Exception(std::format("Failed to write asset pack: {}", outputPath.string())); }
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Usage: perfectform_packer <output.pfpack> <image> [<image>...]");
+        return 1;
+    }
+
+    try
+    {
+        std::vector<PackedImage> images;
+        for (int i = 2; i < argc; ++i)
+        {
+            PackedImage image = LoadImage(argv[i]);
+            const bool duplicate = std::ranges::any_of(
+                images, [&](const PackedImage& other) { return other.entry.name == image.entry.name; });
+            if (duplicate) { throw PF::Exception(std::format("Duplicate image name: {}", image.entry.name.data())); }
+            images.push_back(std::move(image));
+        }
+
+        WritePack(argv[1], images);
+        SDL_Log("Packed %zu images into %s", images.size(), argv[1]);
+    }
+    catch (const std::exception& e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s", e.what());
+        return 1;
+    }
+    return 0;
+}